@@ -0,0 +1,227 @@
+/**
+ * @file bench_float.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Benchmark of the floating-point conversions against glibc.
+ *
+ * @details
+ * Formats the same pseudo-random doubles with `ft_snprintf` and the libc
+ * `snprintf` and reports the average time per call for each, for a few
+ * conversions and three kinds of input:
+ * - `bits`: random bit patterns (every finite double is equally likely)
+ * - `range`: uniform values in [0, 1e6), with 16 to 17 significant digits
+ * - `short`: amounts with two decimals, whose shortest digits are short
+ *
+ * `ft_dtoa` is compared with `%.17g`, the usual libc way to get a string
+ * that reads back exactly. Every output is also compared with glibc's,
+ * so a wrong result fails the run.
+ *
+ * Run with `make bench`.
+ */
+
+#include "libft.h"
+#include <time.h>
+
+#define BENCH_VALUES 4096
+#define BENCH_ROUNDS 100
+#define BENCH_OUT_SIZE 512
+
+/**
+ * @brief Returns the next value of a xorshift64 generator.
+ */
+static uint64_t next_random(uint64_t* state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return (*state);
+}
+
+/**
+ * @brief Fills @p values with doubles of the given kind.
+ */
+static void fill_values(double* values, const char* kind)
+{
+	uint64_t state;
+	uint64_t bits;
+	int      i;
+
+	state = 88172645463325252ULL;
+	i     = 0;
+	while (i < BENCH_VALUES)
+	{
+		bits = next_random(&state);
+		if (kind[0] == 'b')
+			ft_memcpy(&values[i], &bits, sizeof(bits));
+		else if (kind[0] == 'r')
+			values[i] = (double) (bits >> 11) / (1ULL << 53) * 1e6;
+		else
+			values[i] = (double) (bits % 10000000) / 100.0;
+		if (values[i] == values[i] && values[i] - values[i] == 0)
+			i++;
+	}
+}
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/**
+ * @brief Times one format over all values with ft_snprintf or snprintf.
+ *
+ * @return The average time per call, in nanoseconds.
+ */
+static double time_format(const char* format, const double* values, int ours)
+{
+	char   out[BENCH_OUT_SIZE];
+	double start;
+	size_t sum;
+	int    round;
+	int    i;
+
+	sum   = 0;
+	start = now_ns();
+	round = 0;
+	while (round++ < BENCH_ROUNDS)
+	{
+		i = 0;
+		while (i < BENCH_VALUES)
+		{
+			if (ours)
+				sum += ft_snprintf(out, sizeof(out), format, values[i++]);
+			else
+				sum += snprintf(out, sizeof(out), format, values[i++]);
+		}
+	}
+	if (sum == 0)
+		printf("unexpected empty output\n");
+	return ((now_ns() - start) / ((double) BENCH_ROUNDS * BENCH_VALUES));
+}
+
+/**
+ * @brief Times `ft_dtoa` over all values, including its allocation.
+ *
+ * @return The average time per call, in nanoseconds.
+ */
+static double time_dtoa(const double* values)
+{
+	double start;
+	size_t sum;
+	char*  str;
+	int    round;
+	int    i;
+
+	sum   = 0;
+	start = now_ns();
+	round = 0;
+	while (round++ < BENCH_ROUNDS)
+	{
+		i = 0;
+		while (i < BENCH_VALUES)
+		{
+			str = ft_dtoa(values[i++]);
+			sum += (str) ? str[0] : 0;
+			free(str);
+		}
+	}
+	if (sum == 0)
+		printf("unexpected empty output\n");
+	return ((now_ns() - start) / ((double) BENCH_ROUNDS * BENCH_VALUES));
+}
+
+/**
+ * @brief Checks that every value formats exactly like glibc.
+ *
+ * @return 0 if all outputs match, 1 otherwise.
+ */
+static int check_format(const char* format, const double* values)
+{
+	char want[BENCH_OUT_SIZE];
+	char got[BENCH_OUT_SIZE];
+	int  i;
+
+	i = 0;
+	while (i < BENCH_VALUES)
+	{
+		snprintf(want, sizeof(want), format, values[i]);
+		ft_snprintf(got, sizeof(got), format, values[i]);
+		if (ft_strcmp(want, got) != 0)
+		{
+			printf("MISMATCH %s: libc [%s] ft [%s]\n", format, want, got);
+			return (1);
+		}
+		i++;
+	}
+	return (0);
+}
+
+/**
+ * @brief Checks that `ft_dtoa` reads back exactly for every value.
+ *
+ * @return 0 if all values round-trip, 1 otherwise.
+ */
+static int check_dtoa(const double* values)
+{
+	char* str;
+	int   i;
+
+	i = 0;
+	while (i < BENCH_VALUES)
+	{
+		str = ft_dtoa(values[i]);
+		if (!str || strtod(str, NULL) != values[i])
+		{
+			printf("MISMATCH ft_dtoa: %.17g gave %s\n", values[i], str);
+			free(str);
+			return (1);
+		}
+		free(str);
+		i++;
+	}
+	return (0);
+}
+
+int main(void)
+{
+	static const char* kinds[]   = {"bits", "range", "short"};
+	static const char* formats[] = {"%f", "%.2f", "%e", "%g", "%.17g", "%a"};
+	double             values[BENCH_VALUES];
+	double             ours;
+	double             libc;
+	size_t             k;
+	size_t             f;
+	int                failed;
+
+	failed = 0;
+	printf("%-6s %-7s %12s %12s %8s\n", "input", "format", "ft ns/call",
+	       "libc ns/call", "speedup");
+	k = 0;
+	while (k < sizeof(kinds) / sizeof(kinds[0]))
+	{
+		fill_values(values, kinds[k]);
+		f = 0;
+		while (f < sizeof(formats) / sizeof(formats[0]))
+		{
+			failed |= check_format(formats[f], values);
+			ours = time_format(formats[f], values, 1);
+			libc = time_format(formats[f], values, 0);
+			printf("%-6s %-7s %12.1f %12.1f %7.2fx\n", kinds[k], formats[f],
+			       ours, libc, libc / ours);
+			f++;
+		}
+		failed |= check_dtoa(values);
+		ours = time_dtoa(values);
+		libc = time_format("%.17g", values, 0);
+		printf("%-6s %-7s %12.1f %12.1f %7.2fx\n", kinds[k], "ft_dtoa", ours,
+		       libc, libc / ours);
+		k++;
+	}
+	return (failed);
+}
@@ -0,0 +1,216 @@
+/**
+ * @file bench_gnl.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Throughput of line reading over short, long and mixed lines.
+ *
+ * @details
+ * Three temporary files of `BENCH_FILE_SIZE` bytes are read line by
+ * line with `get_next_line`, with a `t_linereader` reading
+ * `BENCH_READ_SIZE` bytes at a time, with `ft_getline_view` on such a
+ * reader, which copies nothing, with `ft_mmap_lines`, which does not
+ * read at all, and by splitting the buffer `ft_read_all` returns:
+ * - `short`: 8-byte lines
+ * - `long`: a single line
+ * - `mixed`: line lengths spread between 1 byte and 64 KiB
+ *
+ * The bytes returned are counted and must add up to the file size, or
+ * the run fails. The time per line and the throughput are reported, so
+ * an algorithm that is quadratic in the line length or in the number of
+ * lines shows at once.
+ *
+ * Run with `make bench`.
+ */
+
+#include "libft.h"
+#include <time.h>
+
+#define BENCH_FILE_SIZE (16 << 20)
+#define BENCH_READ_SIZE 65536
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/**
+ * @brief Writes a temporary file of `BENCH_FILE_SIZE` bytes whose lines
+ *        follow @p kind, and returns its descriptor.
+ */
+static int make_file(const char* kind)
+{
+	char     path[] = "/tmp/bench_gnl_XXXXXX";
+	char*    data;
+	uint32_t state;
+	size_t   next;
+	size_t   i;
+	int      fd;
+
+	fd   = mkstemp(path);
+	data = malloc(BENCH_FILE_SIZE);
+	if (fd == -1 || !data)
+		return (-1);
+	unlink(path);
+	ft_memset(data, 'x', BENCH_FILE_SIZE);
+	state = 2463534242u;
+	next  = 0;
+	i     = 0;
+	while (kind[0] != 'l' && i < BENCH_FILE_SIZE)
+	{
+		state = state * 1103515245 + 12345;
+		next  = (kind[0] == 's') ? 8 : 1 + (state >> 8) % 65536;
+		i += next;
+		if (i <= BENCH_FILE_SIZE)
+			data[i - 1] = '\n';
+	}
+	data[BENCH_FILE_SIZE - 1] = '\n';
+	if (write(fd, data, BENCH_FILE_SIZE) != BENCH_FILE_SIZE)
+		fd = -1;
+	free(data);
+	return (fd);
+}
+
+/**
+ * @brief Reads the next line of a file with the reader named @p name.
+ *
+ * @return The length of the line, or -1 at end of file.
+ */
+static ssize_t next_line(const char* name, t_linereader* reader,
+                         t_mmap_lines* mapped)
+{
+	const char* view;
+	char*       line;
+	size_t      len;
+
+	if (ft_strcmp(name, "ft_mmap_lines") == 0)
+		return ((ft_mmap_lines_next(mapped, &view, &len) == 1) ? (ssize_t) len
+		                                                        : -1);
+	if (ft_strcmp(name, "ft_getline_view") == 0)
+		return ((ft_getline_view(reader, &view, &len) == 1) ? (ssize_t) len
+		                                                     : -1);
+	if (name[0] == 'g')
+		line = get_next_line(reader->fd);
+	else
+		line = ft_linereader_next(reader);
+	if (!line)
+		return (-1);
+	len = ft_strlen(line);
+	free(line);
+	return (len);
+}
+
+/**
+ * @brief Reads a file from the start with one reader and prints the
+ *        cost.
+ *
+ * @return 0 on success, 1 if bytes went missing.
+ */
+static int run(const char* kind, const char* name, int fd)
+{
+	t_linereader reader;
+	t_mmap_lines mapped;
+	double       start;
+	double       secs;
+	size_t       lines;
+	size_t       bytes;
+	ssize_t      len;
+
+	lseek(fd, 0, SEEK_SET);
+	ft_linereader_init(&reader, fd, BENCH_READ_SIZE);
+	ft_mmap_lines_open(&mapped, fd, 0);
+	lines = 0;
+	bytes = 0;
+	start = now_ns();
+	len   = next_line(name, &reader, &mapped);
+	while (len >= 0)
+	{
+		bytes += len;
+		lines++;
+		len = next_line(name, &reader, &mapped);
+	}
+	secs = (now_ns() - start) / 1e9;
+	ft_linereader_destroy(&reader);
+	ft_mmap_lines_close(&mapped);
+	printf("%-7s %-15s %9zu %10.1f %10.1f\n", kind, name, lines,
+	       secs * 1e9 / lines, bytes / secs / (1 << 20));
+	return (bytes != BENCH_FILE_SIZE);
+}
+
+/**
+ * @brief Loads a file from the start with `ft_read_all`, splits it into
+ *        lines in place and prints the cost.
+ *
+ * @return 0 on success, 1 if bytes went missing.
+ */
+static int run_read_all(const char* kind, int fd)
+{
+	double start;
+	double secs;
+	size_t lines;
+	size_t len;
+	char*  data;
+	char*  line;
+	char*  newline;
+
+	lseek(fd, 0, SEEK_SET);
+	start = now_ns();
+	data  = ft_read_all(fd, &len);
+	if (!data)
+		return (1);
+	lines = 0;
+	line  = data;
+	while (line < data + len)
+	{
+		newline = ft_memchr(line, '\n', data + len - line);
+		line    = (newline) ? newline + 1 : data + len;
+		lines++;
+	}
+	secs = (now_ns() - start) / 1e9;
+	free(data);
+	printf("%-7s %-15s %9zu %10.1f %10.1f\n", kind, "ft_read_all", lines,
+	       secs * 1e9 / lines, len / secs / (1 << 20));
+	return (len != BENCH_FILE_SIZE);
+}
+
+/**
+ * @brief Runs every reader over one kind of file.
+ *
+ * @return 0 on success, 1 if a reader lost bytes.
+ */
+static int run_all(const char* kind)
+{
+	int failed;
+	int fd;
+
+	fd = make_file(kind);
+	if (fd == -1)
+		return (1);
+	failed = run(kind, "get_next_line", fd);
+	failed |= run(kind, "t_linereader", fd);
+	failed |= run(kind, "ft_getline_view", fd);
+	failed |= run(kind, "ft_mmap_lines", fd);
+	failed |= run_read_all(kind, fd);
+	close(fd);
+	return (failed);
+}
+
+int main(void)
+{
+	int failed;
+
+	printf("%d MiB per file\n", BENCH_FILE_SIZE >> 20);
+	printf("%-7s %-15s %9s %10s %10s\n", "lines", "reader", "count",
+	       "ns/line", "MiB/s");
+	failed = run_all("short");
+	failed |= run_all("long");
+	failed |= run_all("mixed");
+	if (failed)
+		printf("line reading check FAILED\n");
+	return (failed);
+}
@@ -0,0 +1,292 @@
+/**
+ * @file bench_log.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Enqueue latency of the asynchronous logger against `ft_printf`.
+ *
+ * @details
+ * Several threads log numbered lines at the same time, into a temporary
+ * file, and the time of every call is recorded. The latency percentiles
+ * and the overall throughput are reported for:
+ * - `ft_log` with a large ring and the `LOG_BLOCK` policy
+ * - `ft_log` with a small ring and the `LOG_DROP` policy
+ * - `ft_log_binary`, which records the arguments and leaves the
+ *   formatting to the writer thread
+ * - the synchronous `ft_dprintf` to the file followed by `ft_fflush`,
+ *   which writes every line before returning
+ *
+ * The blocking runs are read back: every line must be present, intact and
+ * in order within its thread, or the run fails. Before the runs, a few
+ * edge-case formats are logged with `ft_log_binary` and must decode to
+ * what `ft_snprintf` prints.
+ *
+ * Run with `make bench`.
+ */
+
+#include "libft.h"
+#include <time.h>
+
+#define BENCH_THREADS 4
+#define BENCH_LINES 100000
+#define BENCH_RING_LARGE 65536
+#define BENCH_RING_SMALL 1024
+#define BENCH_HIST_NS 131072
+
+/**
+ * @brief Arguments and results of one logging thread.
+ */
+typedef struct s_bench_thread
+{
+	pthread_t thread;
+	t_log*    log;
+	int       fd;
+	int       id;
+	int       binary;
+	int*      ns;
+} t_bench_thread;
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+static long now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Logs the lines of one thread, timing every call.
+ */
+static void* log_lines(void* arg)
+{
+	t_bench_thread* t;
+	long            start;
+	int             n;
+
+	t = arg;
+	n = 0;
+	while (n < BENCH_LINES)
+	{
+		start = now_ns();
+		if (t->log && t->binary)
+			ft_log_binary(t->log, "thread %d line %d value %x %s\n", t->id,
+			              n, n * 2654435761u, "payload");
+		else if (t->log)
+			ft_log(t->log, "thread %d line %d value %x %s\n", t->id, n,
+			       n * 2654435761u, "payload");
+		else
+		{
+			ft_dprintf(t->fd, "thread %d line %d value %x %s\n", t->id, n,
+			           n * 2654435761u, "payload");
+			ft_fflush(t->fd);
+		}
+		t->ns[n++] = now_ns() - start;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Checks that every thread's lines are all present, in order.
+ *
+ * @details
+ * The timestamp a binary record starts with is skipped.
+ *
+ * @return 0 on success, 1 otherwise.
+ */
+static int check_output(int fd)
+{
+	int   next[BENCH_THREADS];
+	char* line;
+	char* text;
+	char* end;
+	long  id;
+	int   failed;
+	int   i;
+
+	lseek(fd, 0, SEEK_SET);
+	ft_bzero(next, sizeof(next));
+	failed = 0;
+	line   = get_next_line(fd);
+	while (line)
+	{
+		text = line;
+		if (ft_isdigit(*text) && ft_strchr(text, ' '))
+			text = ft_strchr(text, ' ') + 1;
+		id = strtol(text + 7, &end, 10);
+		if (ft_strncmp(text, "thread ", 7) != 0 || id < 0
+		    || id >= BENCH_THREADS || ft_strncmp(end, " line ", 6) != 0
+		    || strtol(end + 6, NULL, 10) != next[id]++)
+			failed = 1;
+		free(line);
+		line = get_next_line(fd);
+	}
+	i = 0;
+	while (i < BENCH_THREADS)
+		if (next[i++] != BENCH_LINES)
+			failed = 1;
+	return (failed);
+}
+
+/**
+ * @brief Checks that binary records of edge-case formats decode like
+ *        `ft_snprintf` prints them.
+ *
+ * @details
+ * Covers an invalid conversion, whose `%` and following text are
+ * printed as they are, and a `%` at the very end of the format.
+ *
+ * @return 0 on success, 1 otherwise.
+ */
+static int check_decode(void)
+{
+	static const char* formats[] = {"abc %q def %d\n", "%d%%%y %s %\n",
+	                                "x %5.2k y\n"};
+	char               path[]    = "/tmp/bench_log_XXXXXX";
+	char               expected[256];
+	t_log*             log;
+	char*              text;
+	char*              line;
+	size_t             i;
+	int                failed;
+	int                fd;
+
+	fd = mkstemp(path);
+	if (fd == -1)
+		return (1);
+	unlink(path);
+	log = ft_log_open(fd, BENCH_RING_SMALL, LOG_BLOCK);
+	i   = 0;
+	while (i < sizeof(formats) / sizeof(formats[0]))
+		ft_log_binary(log, formats[i++], 42, "str");
+	ft_log_close(log);
+	lseek(fd, 0, SEEK_SET);
+	text = ft_read_all(fd, NULL);
+	close(fd);
+	failed = (text == NULL);
+	line   = text;
+	i      = 0;
+	while (!failed && i < sizeof(formats) / sizeof(formats[0]))
+	{
+		ft_snprintf(expected, sizeof(expected), formats[i++], 42, "str");
+		line = ft_strchr(line, ' ');
+		if (!line || ft_strncmp(line + 1, expected, ft_strlen(expected)))
+			failed = 1;
+		if (failed)
+			printf("ft_log_decode: expected \"%s\"\n", expected);
+		else
+			line += 1 + ft_strlen(expected);
+	}
+	free(text);
+	return (failed);
+}
+
+/**
+ * @brief Returns the latency below which a fraction @p q of the calls
+ *        fall, counting latencies in 1 ns buckets.
+ *
+ * Latencies of `BENCH_HIST_NS` and more share the last bucket.
+ */
+static int percentile(const int* ns, size_t total, double q)
+{
+	static int hist[BENCH_HIST_NS];
+	size_t     seen;
+	size_t     i;
+
+	ft_bzero(hist, sizeof(hist));
+	i = 0;
+	while (i < total)
+	{
+		hist[(ns[i] < BENCH_HIST_NS) ? ns[i] : BENCH_HIST_NS - 1]++;
+		i++;
+	}
+	seen = 0;
+	i    = 0;
+	while (i < BENCH_HIST_NS - 1)
+	{
+		seen += hist[i];
+		if (seen > total * q)
+			break;
+		i++;
+	}
+	return (i);
+}
+
+/**
+ * @brief Runs one configuration and prints its latency percentiles.
+ *
+ * @param name     Label of the run.
+ * @param capacity Ring size, or 0 for synchronous `ft_dprintf`.
+ * @param policy   Ring policy.
+ * @param binary   Whether to log with `ft_log_binary`.
+ * @param ns       Storage for `BENCH_THREADS * BENCH_LINES` latencies.
+ * @return 0 on success, 1 if the output check failed.
+ */
+static int run(const char* name, size_t capacity, t_log_policy policy,
+               int binary, int* ns)
+{
+	static t_bench_thread threads[BENCH_THREADS];
+	char                  path[] = "/tmp/bench_log_XXXXXX";
+	t_log*                log;
+	double                secs;
+	long                  start;
+	size_t                total;
+	int                   fd;
+	int                   i;
+
+	fd = mkstemp(path);
+	if (fd == -1)
+		return (1);
+	unlink(path);
+	log   = (capacity) ? ft_log_open(fd, capacity, policy) : NULL;
+	start = now_ns();
+	i     = 0;
+	while (i < BENCH_THREADS)
+	{
+		threads[i] = (t_bench_thread){0, log, fd, i, binary,
+		                              ns + i * BENCH_LINES};
+		pthread_create(&threads[i].thread, NULL, log_lines, &threads[i]);
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_THREADS)
+		pthread_join(threads[i++].thread, NULL);
+	secs  = (now_ns() - start) / 1e9;
+	total = (size_t) BENCH_THREADS * BENCH_LINES;
+	printf("%-13s %10.0f %8d %8d %8d %8zu\n", name, total / secs,
+	       percentile(ns, total, 0.5), percentile(ns, total, 0.99),
+	       percentile(ns, total, 0.999), ft_log_dropped(log));
+	ft_log_close(log);
+	i = (capacity && policy == LOG_BLOCK) ? check_output(fd) : 0;
+	close(fd);
+	return (i);
+}
+
+int main(void)
+{
+	int* ns;
+	int  failed;
+
+	ns = malloc(sizeof(int) * BENCH_THREADS * BENCH_LINES);
+	if (!ns)
+		return (1);
+	if (check_decode())
+	{
+		free(ns);
+		printf("ft_log_decode check FAILED\n");
+		return (1);
+	}
+	printf("%d threads x %d lines, enqueue latency in ns\n", BENCH_THREADS,
+	       BENCH_LINES);
+	printf("%-13s %10s %8s %8s %8s %8s\n", "mode", "lines/s", "p50", "p99",
+	       "p99.9", "dropped");
+	failed = run("ft_log block", BENCH_RING_LARGE, LOG_BLOCK, 0, ns);
+	failed |= run("ft_log drop", BENCH_RING_SMALL, LOG_DROP, 0, ns);
+	failed |= run("ft_log_binary", BENCH_RING_LARGE, LOG_BLOCK, 1, ns);
+	failed |= run("ft_dprintf", 0, LOG_BLOCK, 0, ns);
+	free(ns);
+	if (failed)
+		printf("ft_log output check FAILED\n");
+	return (failed);
+}
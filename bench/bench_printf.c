@@ -0,0 +1,374 @@
+/**
+ * @file bench_printf.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Benchmark of `ft_printf` against glibc, per format and sink.
+ *
+ * @details
+ * Four kinds of format are printed `BENCH_CALLS` times each:
+ * - `literal`: a long line of text around a single conversion
+ * - `integer`: only integer conversions, with and without length
+ *   modifiers
+ * - `padded`: conversions padded to a field width
+ * - `string`: `%s` conversions, one of them with a precision
+ *
+ * into five sinks, each with its libft function and glibc counterpart:
+ * - `mem`: `ft_snprintf` against `snprintf`
+ * - `null`: `ft_printf` on a standard output redirected to `/dev/null`,
+ *   against `dprintf`; both write once per call
+ * - `null+buf`: `ft_dprintf` against `fprintf`, both buffered across
+ *   calls and flushed at the end of the run
+ * - `pipe`, `pipe+buf`: the same, into a pipe drained by another thread
+ *
+ * The time, the write system calls (`syscw` of `/proc/self/io`) and the
+ * heap allocations (counted by the `malloc` family defined here) are
+ * reported per call. The `mem` outputs are compared with glibc's first,
+ * so a wrong result fails the run.
+ *
+ * Run with `make bench`.
+ */
+
+#include "libft.h"
+#include <time.h>
+
+#define BENCH_CALLS 200000
+#define BENCH_CHECKS 1000
+#define BENCH_OUT_SIZE 256
+
+/**
+ * @brief Where a run prints.
+ */
+typedef enum e_bench_mode
+{
+	BENCH_MEM, ///< Into a caller buffer.
+	BENCH_FD,  ///< Into a descriptor, one write per call.
+	BENCH_BUF  ///< Into a descriptor, buffered across calls.
+} t_bench_mode;
+
+/**
+ * @brief Sink and implementation of one run.
+ */
+typedef struct s_bench_target
+{
+	t_bench_mode mode;
+	int          ours;
+	int          fd;
+	FILE*        file;
+	char         out[BENCH_OUT_SIZE];
+} t_bench_target;
+
+/**
+ * @brief Prints one line of a format through a target.
+ */
+typedef void (*t_bench_emit)(t_bench_target* t, int i);
+
+/**
+ * @brief A format kind and the function printing it.
+ */
+typedef struct s_bench_format
+{
+	const char*  name;
+	t_bench_emit emit;
+} t_bench_format;
+
+/**
+ * @brief Cost of one run, per call.
+ */
+typedef struct s_bench_result
+{
+	double ns;
+	double syscalls;
+	double allocs;
+} t_bench_result;
+
+/**
+ * @brief Prints the arguments through the function the target selects.
+ */
+#define BENCH_EMIT(t, ...)                                                     \
+	do                                                                         \
+	{                                                                          \
+		if ((t)->mode == BENCH_MEM && (t)->ours)                               \
+			ft_snprintf((t)->out, BENCH_OUT_SIZE, __VA_ARGS__);                \
+		else if ((t)->mode == BENCH_MEM)                                       \
+			snprintf((t)->out, BENCH_OUT_SIZE, __VA_ARGS__);                   \
+		else if ((t)->mode == BENCH_FD && (t)->ours)                           \
+			ft_printf(__VA_ARGS__);                                            \
+		else if ((t)->mode == BENCH_FD)                                        \
+			dprintf((t)->fd, __VA_ARGS__);                                     \
+		else if ((t)->ours)                                                    \
+			ft_dprintf((t)->fd, __VA_ARGS__);                                  \
+		else                                                                   \
+			fprintf((t)->file, __VA_ARGS__);                                   \
+	} while (0)
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void  __libc_free(void* ptr);
+
+/**
+ * @brief Returns the number of heap allocations made so far.
+ */
+static size_t* alloc_count(void)
+{
+	static size_t count;
+
+	return (&count);
+}
+
+/**
+ * @brief Counts the allocation, then forwards it to glibc.
+ */
+void* malloc(size_t size)
+{
+	(*alloc_count())++;
+	return (__libc_malloc(size));
+}
+
+/**
+ * @brief Counts the allocation, then forwards it to glibc.
+ */
+void* calloc(size_t count, size_t size)
+{
+	(*alloc_count())++;
+	return (__libc_calloc(count, size));
+}
+
+/**
+ * @brief Counts the allocation, then forwards it to glibc.
+ */
+void* realloc(void* ptr, size_t size)
+{
+	(*alloc_count())++;
+	return (__libc_realloc(ptr, size));
+}
+
+/**
+ * @brief Forwards to glibc.
+ */
+void free(void* ptr)
+{
+	__libc_free(ptr);
+}
+
+/**
+ * @brief Returns the number of write system calls the process has made,
+ *        or -1 if the kernel does not report it.
+ */
+static long write_syscalls(void)
+{
+	char    buf[512];
+	char*   field;
+	ssize_t n;
+	int     fd;
+
+	fd = open("/proc/self/io", O_RDONLY);
+	if (fd == -1)
+		return (-1);
+	n = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (n <= 0)
+		return (-1);
+	buf[n] = '\0';
+	field  = ft_strnstr(buf, "syscw:", n);
+	if (!field)
+		return (-1);
+	return (atol(field + 6));
+}
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static void emit_literal(t_bench_target* t, int i)
+{
+	BENCH_EMIT(t,
+	           "request %d: GET /static/js/application.bundle.js HTTP/1.1 200 "
+	           "OK, served from the local cache\n",
+	           i);
+}
+
+static void emit_integer(t_bench_target* t, int i)
+{
+	BENCH_EMIT(t, "%d %u %x %ld %i %lu\n", i, i * 2654435761u, i,
+	           (long) i * -1000003, -i, (unsigned long) i << 20);
+}
+
+static void emit_padded(t_bench_target* t, int i)
+{
+	BENCH_EMIT(t, "[%12d] [%-16s] [%08x] [%20s]\n", i, "left", i, "right");
+}
+
+static void emit_string(t_bench_target* t, int i)
+{
+	BENCH_EMIT(t, "%s=%s; %s=%.8s; %s\n", "user", "toonsa",
+	           (i & 1) ? "path" : "home", "/usr/local/share/libft", "done");
+}
+
+/**
+ * @brief Drains a pipe until its write end is closed.
+ */
+static void* drain_pipe(void* arg)
+{
+	char buf[65536];
+	int  fd;
+
+	fd = *(int*) arg;
+	while (read(fd, buf, sizeof(buf)) > 0)
+		;
+	return (NULL);
+}
+
+/**
+ * @brief Checks that a format prints like glibc into memory.
+ *
+ * @return 0 on success, 1 otherwise.
+ */
+static int check_format(const t_bench_format* format)
+{
+	t_bench_target ours;
+	t_bench_target libc;
+	int            i;
+
+	ft_bzero(&ours, sizeof(ours));
+	ft_bzero(&libc, sizeof(libc));
+	ours.ours = 1;
+	i         = 0;
+	while (i < BENCH_CHECKS)
+	{
+		format->emit(&ours, i);
+		format->emit(&libc, i++);
+		if (ft_strcmp(ours.out, libc.out) != 0)
+		{
+			printf("%s: \"%s\" != \"%s\"\n", format->name, ours.out,
+			       libc.out);
+			return (1);
+		}
+	}
+	return (0);
+}
+
+/**
+ * @brief Prints a format `BENCH_CALLS` times through a target.
+ *
+ * @details
+ * `ft_printf` always writes to standard output, which is redirected to
+ * the target descriptor for the run. A buffered run includes its final
+ * flush.
+ */
+static t_bench_result run(const t_bench_format* format, t_bench_target* t)
+{
+	t_bench_result result;
+	double         start;
+	size_t         allocs;
+	long           syscalls;
+	int            saved;
+	int            i;
+
+	saved = -1;
+	if (t->mode == BENCH_FD && t->ours)
+	{
+		fflush(stdout);
+		saved = dup(STDOUT_FILENO);
+		dup2(t->fd, STDOUT_FILENO);
+	}
+	syscalls = write_syscalls();
+	allocs   = *alloc_count();
+	start    = now_ns();
+	i        = 0;
+	while (i < BENCH_CALLS)
+		format->emit(t, i++);
+	if (t->mode == BENCH_BUF && t->ours)
+		ft_fflush(t->fd);
+	else if (t->mode == BENCH_BUF)
+		fflush(t->file);
+	result.ns       = (now_ns() - start) / BENCH_CALLS;
+	result.allocs   = (double) (*alloc_count() - allocs) / BENCH_CALLS;
+	result.syscalls = -1;
+	if (syscalls >= 0)
+		result.syscalls = (double) (write_syscalls() - syscalls) / BENCH_CALLS;
+	if (saved != -1)
+	{
+		dup2(saved, STDOUT_FILENO);
+		close(saved);
+	}
+	return (result);
+}
+
+/**
+ * @brief Runs a format into one sink with both implementations and
+ *        prints the two results side by side.
+ */
+static void compare(const t_bench_format* format, const char* sink,
+                    t_bench_mode mode, int fd, FILE* file)
+{
+	static t_bench_target t;
+	t_bench_result        ours;
+	t_bench_result        libc;
+
+	t      = (t_bench_target){mode, 1, fd, file, {0}};
+	ours   = run(format, &t);
+	t.ours = 0;
+	libc   = run(format, &t);
+	printf("%-8s %-9s %9.1f %8.3f %8.3f %9.1f %8.3f %8.3f\n", format->name,
+	       sink, ours.ns, ours.syscalls, ours.allocs, libc.ns, libc.syscalls,
+	       libc.allocs);
+}
+
+int main(void)
+{
+	static const t_bench_format formats[] = {
+	    {"literal", emit_literal},
+	    {"integer", emit_integer},
+	    {"padded", emit_padded},
+	    {"string", emit_string},
+	};
+	pthread_t drainer;
+	FILE*     null_file;
+	FILE*     pipe_file;
+	int       null_fd;
+	int       pipe_fds[2];
+	size_t    i;
+
+	null_fd = open("/dev/null", O_WRONLY);
+	if (null_fd == -1 || pipe(pipe_fds) == -1)
+		return (1);
+	null_file = fdopen(dup(null_fd), "w");
+	pipe_file = fdopen(dup(pipe_fds[1]), "w");
+	if (!null_file || !pipe_file)
+		return (1);
+	pthread_create(&drainer, NULL, drain_pipe, &pipe_fds[0]);
+	i = 0;
+	while (i < sizeof(formats) / sizeof(formats[0]))
+		if (check_format(&formats[i++]))
+			return (1);
+	printf("%d calls per run; per call: time in ns, write syscalls, "
+	       "allocations\n",
+	       BENCH_CALLS);
+	printf("%-8s %-9s %9s %8s %8s %9s %8s %8s\n", "format", "sink", "ft ns",
+	       "sys", "alloc", "libc ns", "sys", "alloc");
+	i = 0;
+	while (i < sizeof(formats) / sizeof(formats[0]))
+	{
+		compare(&formats[i], "mem", BENCH_MEM, -1, NULL);
+		compare(&formats[i], "null", BENCH_FD, null_fd, null_file);
+		compare(&formats[i], "null+buf", BENCH_BUF, null_fd, null_file);
+		compare(&formats[i], "pipe", BENCH_FD, pipe_fds[1], pipe_file);
+		compare(&formats[i], "pipe+buf", BENCH_BUF, pipe_fds[1], pipe_file);
+		i++;
+	}
+	fclose(null_file);
+	fclose(pipe_file);
+	close(pipe_fds[1]);
+	pthread_join(drainer, NULL);
+	close(pipe_fds[0]);
+	close(null_fd);
+	return (0);
+}
@@ -0,0 +1,253 @@
+/**
+ * @file bench_threads.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Multi-threaded stress test and benchmark of `ft_printf`.
+ *
+ * @details
+ * Several threads print numbered lines with `ft_printf` at the same time,
+ * into a temporary file opened in append mode that replaces standard
+ * output. The file is then read back and every line is checked: it must
+ * be complete, hold only its own thread's payload, and come in order
+ * within its thread. Some lines are longer than `PF_BUF_SIZE`, so the
+ * heap spill path is exercised too. A failed check fails the run.
+ *
+ * The same load is then printed with the libc `printf`, which locks the
+ * shared `stdout` stream and writes it in blocks, and with `printf`
+ * flushed after every line under `flockfile`, the libc way to get whole
+ * lines per `write`. The throughput of each is reported.
+ *
+ * Run with `make bench`.
+ */
+
+#include "libft.h"
+#include <time.h>
+
+#define BENCH_THREADS 8
+#define BENCH_LINES 20000
+#define BENCH_LONG_EVERY 97
+#define BENCH_LONG_LEN 6000
+#define BENCH_PAYLOAD_MAX 120
+
+/**
+ * @brief Arguments of one printing thread.
+ */
+typedef struct s_bench_thread
+{
+	pthread_t thread;
+	int       id;
+	int       mode;
+	char      payload[BENCH_LONG_LEN + 1];
+} t_bench_thread;
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+/**
+ * @brief Returns the payload length of line @p n.
+ */
+static int payload_len(int n)
+{
+	if (n % BENCH_LONG_EVERY == 0)
+		return (BENCH_LONG_LEN);
+	return (n * 7919 % BENCH_PAYLOAD_MAX);
+}
+
+/**
+ * @brief Prints the lines of one thread.
+ */
+static void* print_lines(void* arg)
+{
+	t_bench_thread* t;
+	const char*     payload;
+	int             n;
+
+	t = arg;
+	n = 0;
+	while (n < BENCH_LINES)
+	{
+		payload = t->payload + BENCH_LONG_LEN - payload_len(n);
+		if (t->mode == 0)
+			ft_printf("t=%d n=%d len=%d %s\n", t->id, n, payload_len(n),
+			          payload);
+		else
+		{
+			flockfile(stdout);
+			printf("t=%d n=%d len=%d %s\n", t->id, n, payload_len(n),
+			       payload);
+			if (t->mode == 2)
+				fflush(stdout);
+			funlockfile(stdout);
+		}
+		n++;
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Runs every thread once and returns the elapsed time in seconds.
+ *
+ * @param threads The threads to run.
+ * @param mode 0 for `ft_printf`, 1 for `printf`, 2 for `printf` flushed
+ *             after every line.
+ */
+static double run_threads(t_bench_thread* threads, int mode)
+{
+	double start;
+	int    i;
+
+	start = now_ns();
+	i     = 0;
+	while (i < BENCH_THREADS)
+	{
+		threads[i].mode = mode;
+		pthread_create(&threads[i].thread, NULL, print_lines, &threads[i]);
+		i++;
+	}
+	i = 0;
+	while (i < BENCH_THREADS)
+		pthread_join(threads[i++].thread, NULL);
+	fflush(stdout);
+	return ((now_ns() - start) / 1e9);
+}
+
+/**
+ * @brief Checks one line against the format `print_lines` uses.
+ *
+ * @return 0 if the line is intact and in order, 1 otherwise.
+ */
+static int check_line(char* line, int* next)
+{
+	char* end;
+	long  id;
+	long  n;
+	long  len;
+	long  i;
+
+	if (ft_strncmp(line, "t=", 2) != 0)
+		return (1);
+	id = strtol(line + 2, &end, 10);
+	if (id < 0 || id >= BENCH_THREADS || ft_strncmp(end, " n=", 3) != 0)
+		return (1);
+	n = strtol(end + 3, &end, 10);
+	if (n != next[id] || ft_strncmp(end, " len=", 5) != 0)
+		return (1);
+	len = strtol(end + 5, &end, 10);
+	if (len != payload_len(n) || *end != ' ')
+		return (1);
+	i = 0;
+	while (i < len)
+		if (end[1 + i++] != 'a' + id)
+			return (1);
+	next[id]++;
+	return (end[1 + len] != '\0');
+}
+
+/**
+ * @brief Reads the output file back and checks every line.
+ *
+ * @return 0 if every line is intact and none is missing, 1 otherwise.
+ */
+static int check_output(int fd)
+{
+	int    next[BENCH_THREADS];
+	char*  line;
+	size_t len;
+	int    failed;
+	int    i;
+
+	lseek(fd, 0, SEEK_SET);
+	ft_bzero(next, sizeof(next));
+	failed = 0;
+	line   = get_next_line(fd);
+	while (line)
+	{
+		len = ft_strlen(line);
+		if (line[len - 1] == '\n')
+			line[len - 1] = '\0';
+		if (!failed && check_line(line, next))
+		{
+			printf("BROKEN LINE: %.80s\n", line);
+			failed = 1;
+		}
+		free(line);
+		line = get_next_line(fd);
+	}
+	i = 0;
+	while (i < BENCH_THREADS)
+		if (next[i++] != BENCH_LINES)
+			failed = 1;
+	return (failed);
+}
+
+/**
+ * @brief Redirects standard output to a new temporary file.
+ *
+ * @return The descriptor of the file, or -1 on failure.
+ */
+static int open_output(void)
+{
+	char path[] = "/tmp/bench_threads_XXXXXX";
+	int  fd;
+
+	fd = mkstemp(path);
+	if (fd == -1)
+		return (-1);
+	unlink(path);
+	fcntl(fd, F_SETFL, O_APPEND);
+	fflush(stdout);
+	dup2(fd, STDOUT_FILENO);
+	return (fd);
+}
+
+int main(void)
+{
+	static t_bench_thread threads[BENCH_THREADS];
+	static const char*    names[] = {"ft_printf", "printf", "printf+flush"};
+	double                secs[3];
+	int                   saved;
+	int                   fd;
+	int                   failed;
+	int                   i;
+
+	i = 0;
+	while (i < BENCH_THREADS)
+	{
+		threads[i].id = i;
+		ft_memset(threads[i].payload, 'a' + i, BENCH_LONG_LEN);
+		i++;
+	}
+	saved  = dup(STDOUT_FILENO);
+	failed = 0;
+	i      = 0;
+	while (i < 3)
+	{
+		fd = open_output();
+		if (saved == -1 || fd == -1)
+			return (1);
+		secs[i] = run_threads(threads, i);
+		dup2(saved, STDOUT_FILENO);
+		if (i == 0)
+			failed = check_output(fd);
+		close(fd);
+		i++;
+	}
+	printf("%d threads x %d lines, ft_printf line integrity: %s\n",
+	       BENCH_THREADS, BENCH_LINES, (failed) ? "FAILED" : "ok");
+	i = 0;
+	while (i < 3)
+	{
+		printf("%-12s %12.0f lines/s\n", names[i],
+		       BENCH_THREADS * BENCH_LINES / secs[i]);
+		i++;
+	}
+	return (failed);
+}
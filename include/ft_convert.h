@@ -34,6 +34,7 @@
  * - @ref ft_atoll
  * - @ref ft_utoa
  * - @ref ft_itoa_base
+ * - @ref ft_dtoa
  *
  * @{
  */
@@ -43,6 +44,7 @@ long long ft_atoll(const char* str);
 char*     ft_utoa(unsigned long long n);
 char*     ft_itoa(int n);
 char*     ft_itoa_base(unsigned long long n, int base, int uppercase);
+char*     ft_dtoa(double n);
 
 /** @} */ // end of number_conversions group
 
@@ -30,6 +30,17 @@
  * - @ref ft_read_file
  * - @ref ft_safe_close
  * - @ref get_next_line
+ * - @ref ft_gnl_release
+ * - @ref ft_gnl_release_all
+ * - @ref ft_linereader_init
+ * - @ref ft_linereader_next
+ * - @ref ft_linereader_destroy
+ * - @ref ft_getline_view
+ * - @ref ft_getline
+ * - @ref ft_mmap_lines_open
+ * - @ref ft_mmap_lines_next
+ * - @ref ft_mmap_lines_close
+ * - @ref ft_read_all
  * @{
  */
 
@@ -41,11 +52,119 @@
 #endif
 
 /**
- * @brief Maximum number of file descriptors supported simultaneously.
+ * @brief Smallest number of slots in the `get_next_line` reader table.
  *
- * Used internally to manage static buffers indexed by file descriptors.
+ * Must be a power of two.
  */
+#define GNL_TABLE_MIN 8
+
+/**
+ * @brief Former limit on the file descriptors `get_next_line` accepted.
+ *
+ * @deprecated `get_next_line` no longer has a descriptor limit and the
+ * library does not use this value. It is kept so code that sized its
+ * own arrays with it still builds.
+ */
+#ifndef MAX_FD
 #define MAX_FD 1024
+#endif
+
+/**
+ * @brief Default bytes mapped at a time by `ft_mmap_lines_open`.
+ */
+#ifndef MMAP_LINES_WINDOW
+#define MMAP_LINES_WINDOW (64 << 20)
+#endif
+
+/**
+ * @brief Bytes read at a time when `ft_mmap_lines` falls back to reads.
+ */
+#ifndef MMAP_LINES_READ_SIZE
+#define MMAP_LINES_READ_SIZE 65536
+#endif
+
+/**
+ * @brief First buffer size of `ft_read_all` on descriptors of unknown
+ *        size, such as pipes, and the least it starts from otherwise.
+ */
+#ifndef READ_ALL_MIN_SIZE
+#define READ_ALL_MIN_SIZE 4096
+#endif
+
+/**
+ * @typedef t_linereader
+ * @brief Line reader over one file descriptor, owned by the caller.
+ *
+ * @details
+ * `data` holds `cap` bytes, of which `[start, end)` have been read but
+ * not returned yet. `[start, scanned)` is known to hold no newline, so
+ * each byte is searched only once. Each read asks for `read_size`
+ * bytes. `error` is set when a call fails on a read or an allocation,
+ * and cleared by the next call, so it tells a failure from end of file
+ * for the last call only.
+ *
+ * On a seekable descriptor, the reader keeps its own position in
+ * `offset` and reads with `pread`, so several readers can walk the same
+ * file independently; `offset` is -1 on pipes and sockets, which are
+ * read with `read`. A reader holds no global state: threads can each
+ * stream their own readers concurrently.
+ */
+typedef struct s_linereader
+{
+	int    fd;
+	int    error;
+	off_t  offset;
+	size_t read_size;
+	char*  data;
+	size_t start;
+	size_t scanned;
+	size_t end;
+	size_t cap;
+} t_linereader;
+
+/**
+ * @typedef t_mmap_lines
+ * @brief Line iterator over a memory-mapped file, owned by the caller.
+ *
+ * @details
+ * `map` holds `map_len` bytes of the file from offset `base`, a page
+ * boundary; the next line starts at offset `pos`. `size` is the size of
+ * the file when it was opened, or -1 when lines come from `reader`
+ * because the descriptor cannot be mapped. `error` is set after a
+ * failed `mmap`.
+ */
+typedef struct s_mmap_lines
+{
+	int          fd;
+	int          error;
+	off_t        size;
+	off_t        pos;
+	off_t        base;
+	char*        map;
+	size_t       map_len;
+	size_t       window;
+	t_linereader reader;
+} t_mmap_lines;
+
+/**
+ * @typedef t_gnl_table
+ * @brief Line readers of `get_next_line`, keyed by file descriptor.
+ *
+ * @details
+ * An open-addressing hash table with linear probing: the reader of `fd`
+ * sits in the first slot from `fd & (count - 1)` on, and knows its own
+ * descriptor. A reader exists only while its descriptor has pending
+ * input, and `active` counts them. `count`, a power of two, is at least
+ * twice `active` and, above `GNL_TABLE_MIN`, less than eight times it,
+ * so the table costs memory for the descriptors being read rather than
+ * for the highest of them. It is freed when `active` drops to zero.
+ */
+typedef struct s_gnl_table
+{
+	t_linereader** readers;
+	int            count;
+	int            active;
+} t_gnl_table;
 
 /**
  * @brief Opens a file with the given flags.
@@ -85,6 +204,108 @@ int ft_safe_close(int fd);
  */
 char* get_next_line(int fd);
 
+/**
+ * @brief Reads a line from a file descriptor, with its length.
+ *
+ * Like `get_next_line`, on the same per-descriptor state, but the length
+ * is reported, so lines holding NUL bytes come back whole.
+ *
+ * @param fd The file descriptor to read from.
+ * @param len Receives the length of the line (may be NULL).
+ * @return A newly allocated, null-terminated line, or NULL at end of file
+ *         or on failure.
+ */
+char* ft_getline(int fd, size_t* len);
+
+/**
+ * @brief Frees the pending input `get_next_line` keeps for a descriptor.
+ *
+ * @param fd The file descriptor, typically about to be closed.
+ */
+void ft_gnl_release(int fd);
+
+/**
+ * @brief Frees the pending input of every descriptor.
+ */
+void ft_gnl_release_all(void);
+
+/**
+ * @brief Prepares a line reader over a file descriptor.
+ *
+ * @param reader The reader to initialize.
+ * @param fd The file descriptor to read from.
+ * @param read_size Bytes asked for by each `read` (0 for `BUFFER_SIZE`).
+ * @return 0 on success, -1 if `reader` is NULL or `fd` is negative.
+ */
+int ft_linereader_init(t_linereader* reader, int fd, size_t read_size);
+
+/**
+ * @brief Returns the next line of a reader.
+ *
+ * @param reader The reader.
+ * @return A newly allocated line, or NULL at end of file or on error.
+ */
+char* ft_linereader_next(t_linereader* reader);
+
+/**
+ * @brief Frees the buffer of a reader, leaving its descriptor open.
+ *
+ * @param reader The reader.
+ */
+void ft_linereader_destroy(t_linereader* reader);
+
+/**
+ * @brief Returns the next line of a reader as a view into its buffer.
+ *
+ * @param reader The reader.
+ * @param line Receives the start of the line, valid until the next call.
+ * @param len Receives the length of the line.
+ * @return 1 if a line was returned, 0 at end of file, or -1 on error.
+ */
+int ft_getline_view(t_linereader* reader, const char** line, size_t* len);
+
+/**
+ * @brief Prepares a line iterator over a memory-mapped file.
+ *
+ * @param lines The iterator to initialize.
+ * @param fd The file descriptor to read from.
+ * @param window Bytes mapped at a time (0 for `MMAP_LINES_WINDOW`).
+ * @return 0 on success, -1 on invalid arguments or if `fstat` fails.
+ */
+int ft_mmap_lines_open(t_mmap_lines* lines, int fd, size_t window);
+
+/**
+ * @brief Returns the next line of a file as a view.
+ *
+ * @param lines The iterator.
+ * @param line Receives the start of the line, valid until the next call.
+ * @param len Receives the length of the line.
+ * @return 1 if a line was returned, 0 at end of file, or -1 on error.
+ */
+int ft_mmap_lines_next(t_mmap_lines* lines, const char** line, size_t* len);
+
+/**
+ * @brief Releases the mapping or buffer of an iterator.
+ *
+ * @param lines The iterator.
+ */
+void ft_mmap_lines_close(t_mmap_lines* lines);
+
+/**
+ * @brief Reads everything left on a file descriptor into one buffer.
+ *
+ * @param fd The file descriptor to read from.
+ * @param len Receives the number of bytes read (may be NULL).
+ * @return A newly allocated, null-terminated buffer, or NULL on failure.
+ */
+char* ft_read_all(int fd, size_t* len);
+
+/* ************************************************************************** */
+/*                       INTERNAL LINE READER OPERATIONS                      */
+/* ************************************************************************** */
+
+char* linereader_copy_line(t_linereader* reader, size_t* len);
+
 /** @} */ // end of file_utils group
 
 #endif
@@ -0,0 +1,254 @@
+/**
+ * @file ft_log.h
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Asynchronous logger backed by a lock-free ring buffer.
+ *
+ * @details
+ * This header declares the `t_log` type and its operations. A logger
+ * owns a fixed ring of message slots and a background writer thread:
+ * - `ft_log` claims a slot with a single compare-and-swap, formats the
+ *   message into it with the `ft_printf` engine and publishes it; it
+ *   takes no lock and makes no system call in the common case
+ * - the writer thread drains the published slots in order and hands
+ *   them to the descriptor in batches with `writev`
+ *
+ * `ft_log_binary` defers the formatting too: it only records the format
+ * pointer, a timestamp and the raw arguments, and the writer thread
+ * renders the message through the `ft_printf` engine before writing it.
+ *
+ * Memory is bounded by the ring: `capacity` slots of `LOG_SLOT_SIZE`
+ * bytes, allocated once by `ft_log_open`. When the ring is full, the
+ * logger's `t_log_policy` decides whether `ft_log` drops the message or
+ * waits for room. `ft_log_close` writes every pending message before it
+ * returns.
+ *
+ * @note
+ * - Any number of threads may call `ft_log` and `ft_log_flush` on the
+ *   same logger; `ft_log_close` must be called once, after they stop.
+ * - A message longer than `LOG_MSG_MAX - 1` bytes is cut, and its last
+ *   byte becomes a newline so lines stay separated. The same holds for
+ *   binary records at `LOG_MSG_MAX` bytes of arguments and at
+ *   `LOG_TEXT_MAX - 1` bytes of rendered text.
+ * - The format given to `ft_log_binary` is read again when the record
+ *   is rendered, so it must outlive the logger (a string literal).
+ *
+ * @ingroup log
+ */
+
+#ifndef FT_LOG_H
+#define FT_LOG_H
+
+/**
+ * @defgroup log Asynchronous Logging
+ * @brief Formatted logging with the write cost moved off the caller.
+ *
+ * @details
+ * This group includes:
+ * - @ref ft_log_open
+ * - @ref ft_log
+ * - @ref ft_vlog
+ * - @ref ft_log_binary
+ * - @ref ft_vlog_binary
+ * - @ref ft_log_decode
+ * - @ref ft_log_flush
+ * - @ref ft_log_dropped
+ * - @ref ft_log_close
+ *
+ * @{
+ */
+
+/**
+ * @brief Size of one ring slot, header included.
+ */
+#ifndef LOG_SLOT_SIZE
+#define LOG_SLOT_SIZE 256
+#endif
+
+/**
+ * @brief Room for the message text or binary record in a slot,
+ *        terminator included.
+ */
+#define LOG_MSG_MAX (LOG_SLOT_SIZE - sizeof(size_t) - 2 * sizeof(uint32_t))
+
+/**
+ * @brief Longest text a binary record renders to, terminator included.
+ */
+#define LOG_TEXT_MAX 512
+
+/**
+ * @brief Most messages the writer thread hands to one `writev`.
+ */
+#define LOG_BATCH 64
+
+/**
+ * @brief Size the producer and consumer counters are padded to, so they
+ *        sit on different cache lines.
+ */
+#define LOG_CACHE_LINE 64
+
+/**
+ * @typedef t_log_policy
+ * @brief What `ft_log` does when the ring is full.
+ */
+typedef enum e_log_policy
+{
+	LOG_DROP,  ///< Discard the message and count it.
+	LOG_BLOCK  ///< Wait until the writer thread frees a slot.
+} t_log_policy;
+
+/**
+ * @typedef t_log_slot
+ * @brief One message slot of the ring.
+ *
+ * @details
+ * `seq` tells who owns the slot: it equals the ring position when the
+ * slot is free for that position, and the position plus one once the
+ * message for it is published. A binary slot holds a record of
+ * `ft_log_binary` instead of text.
+ */
+typedef struct s_log_slot
+{
+	atomic_size_t seq;               ///< Ownership sequence number.
+	uint32_t      len;               ///< Length of the message.
+	uint32_t      binary;            ///< Set for a binary record.
+	char          data[LOG_MSG_MAX]; ///< Message text or record.
+} t_log_slot;
+
+/**
+ * @typedef t_log
+ * @brief Handle to an asynchronous logger.
+ *
+ * @details
+ * `head` is the next position producers claim and `tail` the next one
+ * the writer thread drains; each sits on its own cache line. `lock` and
+ * `wake` only serve to put the idle writer thread to sleep, which
+ * producers wake through `sleeping` without taking the lock. `drained`
+ * is broadcast under `lock` after a batch is written while `flushers`
+ * threads wait in `ft_log_flush`.
+ */
+typedef struct s_log
+{
+	atomic_size_t   head;     ///< Next position to claim.
+	char            pad_head[LOG_CACHE_LINE - sizeof(atomic_size_t)];
+	atomic_size_t   tail;     ///< Next position to write.
+	char            pad_tail[LOG_CACHE_LINE - sizeof(atomic_size_t)];
+	atomic_size_t   dropped;  ///< Messages discarded by `LOG_DROP`.
+	atomic_int      sleeping; ///< Set while the writer thread is idle.
+	atomic_int      running;  ///< Cleared by `ft_log_close`.
+	atomic_int      failed;   ///< Set after a failed write.
+	atomic_int      flushers; ///< Threads waiting in `ft_log_flush`.
+	t_log_slot*     slots;    ///< The ring, `mask + 1` slots.
+	size_t          mask;     ///< Ring size minus one (a power of two).
+	int             fd;       ///< Destination descriptor.
+	t_log_policy    policy;   ///< Behavior when the ring is full.
+	pthread_t       thread;   ///< The writer thread.
+	pthread_mutex_t lock;     ///< Guards the writer thread's sleep.
+	pthread_cond_t  wake;     ///< Signaled to wake the writer thread.
+	pthread_cond_t  drained;  ///< Broadcast after a batch is written.
+} t_log;
+
+/**
+ * @brief Creates a logger and starts its writer thread.
+ *
+ * @param fd       Descriptor the messages are written to.
+ * @param capacity Number of slots (rounded up to a power of two, at
+ *                 least 2).
+ * @param policy   What `ft_log` does when the ring is full.
+ * @return A new logger, or NULL on failure.
+ */
+t_log* ft_log_open(int fd, size_t capacity, t_log_policy policy);
+
+/**
+ * @brief Formats a message into the logger's ring.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string.
+ * @param ...    Arguments matching the format.
+ * @return The number of bytes queued, or -1 if the message was dropped.
+ */
+int ft_log(t_log* log, const char* format, ...);
+
+/**
+ * @brief Formats a message into the logger's ring, with a `va_list`.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string.
+ * @param args   Arguments matching the format.
+ * @return The number of bytes queued, or -1 if the message was dropped.
+ */
+int ft_vlog(t_log* log, const char* format, va_list args);
+
+/**
+ * @brief Records a message to be formatted later by the writer thread.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string that outlives the logger.
+ * @param ...    Arguments matching the format.
+ * @return The size of the record queued, or -1 if it was dropped.
+ */
+int ft_log_binary(t_log* log, const char* format, ...);
+
+/**
+ * @brief Records a message to be formatted later, with a `va_list`.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string that outlives the logger.
+ * @param args   Arguments matching the format.
+ * @return The size of the record queued, or -1 if it was dropped.
+ */
+int ft_vlog_binary(t_log* log, const char* format, va_list args);
+
+/**
+ * @brief Renders a binary record as text.
+ *
+ * @param record The record, as stored by `ft_log_binary`.
+ * @param len    Its size in bytes.
+ * @param out    Destination buffer (may be NULL if @p size is 0).
+ * @param size   Size of @p out in bytes.
+ * @return The length of the full text (`snprintf` semantics), or -1 on
+ *         error.
+ */
+int ft_log_decode(const char* record, size_t len, char* out, size_t size);
+
+/**
+ * @brief Waits until every message queued so far has been written.
+ *
+ * @param log The logger.
+ * @return 0 on success, -1 if a write has failed.
+ */
+int ft_log_flush(t_log* log);
+
+/**
+ * @brief Returns how many messages `LOG_DROP` has discarded.
+ *
+ * @param log The logger.
+ * @return The number of dropped messages.
+ */
+size_t ft_log_dropped(t_log* log);
+
+/**
+ * @brief Writes the pending messages, stops the writer thread and frees
+ *        the logger.
+ *
+ * @param log The logger (NULL is ignored).
+ * @return 0 on success, -1 if a write has failed.
+ */
+int ft_log_close(t_log* log);
+
+/* ************************************************************************** */
+/*                          INTERNAL RING OPERATIONS                          */
+/* ************************************************************************** */
+
+t_log_slot* log_claim_slot(t_log* log, size_t* pos);
+void        log_publish_slot(t_log* log, t_log_slot* slot, size_t pos);
+void        log_wake_writer(t_log* log);
+size_t      log_drain(t_log* log);
+size_t      log_format_slot(t_log_slot* slot, const char* format,
+                            va_list args);
+size_t      log_render_slot(t_log_slot* slot, char* text);
+void*       log_writer_main(void* arg);
+
+/** @} */ // end of log group
+
+#endif
@@ -25,7 +25,7 @@
  * This group contains functions that replicate or extend common C
  * standard library memory operations, including:
  *
- * - Allocation (`ft_calloc`, `ft_realloc`)
+ * - Allocation (`ft_calloc`, `ft_realloc`, `ft_memdup`)
  * - Initialization (`ft_bzero`, `ft_memset`)
  * - Copying and moving (`ft_memcpy`, `ft_memmove`)
  * - Comparison and search (`ft_memcmp`, `ft_memchr`)
@@ -40,6 +40,7 @@
  * - @ref ft_memchr
  * - @ref ft_memcmp
  * - @ref ft_memcpy
+ * - @ref ft_memdup
  * - @ref ft_memmove
  * - @ref ft_memset
  * @{
@@ -51,6 +52,7 @@ void  ft_bzero(void* s, size_t n);
 void* ft_memchr(const void* buffer, int c, size_t count);
 int   ft_memcmp(const void* buffer1, const void* buffer2, size_t count);
 void* ft_memcpy(void* dest, const void* src, size_t count);
+void* ft_memdup(const void* src, size_t count);
 void* ft_memmove(void* dest, const void* src, size_t count);
 void* ft_memset(void* dest, int c, size_t count);
 
@@ -29,6 +29,15 @@
  * - Format string parsing
  * - Handling of flags, width, precision
  * - Type specifiers (e.g., %d, %s, %x, etc.)
+ * - Length modifiers (`hh`, `h`, `l`, `ll`, `j`, `z`, `t`) for 64-bit
+ *   integers
+ * - Output sinks: a file descriptor, a caller buffer or a growing heap
+ *   buffer (`ft_printf`, `ft_snprintf`, `ft_asprintf`)
+ * - Per-descriptor buffering across calls (`ft_dprintf`, `ft_fflush`)
+ * - Thread safety: each `ft_printf` call leaves in one `write`
+ * - Formats compiled once and run many times (`ft_printf_compile`)
+ * - Floating-point conversions (`%f`, `%e`, `%g`, `%a`), correctly rounded
+ * - Custom conversions registered at run time (`ft_printf_register`)
  * @{
  */
 
@@ -38,43 +47,302 @@
 #define FLAG_PLUS (1 << 3)  /**< '+' flag: show plus sign */
 #define FLAG_SPACE (1 << 4) /**< ' ' flag: leading space */
 
+/**
+ * @brief Size of the stack buffer `ft_printf` formats into.
+ *
+ * Output is written when the buffer fills up or the call ends, so any
+ * call producing fewer bytes than this costs a single `write`.
+ */
+#ifndef PF_BUF_SIZE
+#define PF_BUF_SIZE 4096
+#endif
+
+/**
+ * @brief Size of the stack buffer integer conversions render digits into.
+ *
+ * Large enough for a 64-bit value in any base down to octal.
+ */
+#define PF_NUM_BUF_SIZE 24
+
+/**
+ * @brief Most significant digits a `t_pf_dec` can hold.
+ *
+ * The exact decimal expansion of a double has at most 767 of them.
+ */
+#define PF_DEC_DIGITS 800
+
+/**
+ * @brief 64-bit limbs of the longest fraction of a double, 2^-1074.
+ */
+#define PF_FRAC_WORDS 17
+
+/**
+ * @brief Size of the persistent buffer `ft_dprintf` keeps per descriptor.
+ *
+ * Output to a descriptor accumulates across calls until this many bytes
+ * are pending, `ft_fflush` is called, or the program exits.
+ */
+#ifndef PF_FD_BUF_SIZE
+#define PF_FD_BUF_SIZE 16384
+#endif
+
+/**
+ * @brief Descriptors whose pending `ft_dprintf` output is tracked in a
+ *        lock-free bitmap (0 to `PF_PENDING_FDS - 1`).
+ */
+#define PF_PENDING_FDS 64
+
+/**
+ * @enum e_pf_length
+ * @brief Length modifier of an integer conversion.
+ *
+ * Selects the type the argument is read as: `char`, `short`, `long`,
+ * `long long`, `intmax_t`, `size_t` or `ptrdiff_t`, or `int` when no
+ * modifier is given.
+ */
+typedef enum e_pf_length
+{
+	PF_LEN_NONE,
+	PF_LEN_HH,
+	PF_LEN_H,
+	PF_LEN_L,
+	PF_LEN_LL,
+	PF_LEN_J,
+	PF_LEN_Z,
+	PF_LEN_T
+} t_pf_length;
+
 /**
  * @struct s_fmt
  * @brief Format specifier data.
  *
- * Stores parsed flags, field width, precision, and the actual type specifier.
+ * Stores parsed flags, field width, precision, length modifier, and the
+ * actual type specifier.
  */
 typedef struct s_fmt
 {
-	int  flags;
-	int  width;
-	int  precision;
-	char specifier;
+	int         flags;
+	int         width;
+	int         precision;
+	t_pf_length length;
+	char        specifier;
 } t_fmt;
 
+/**
+ * @struct s_pf_dec
+ * @brief Decimal digits of a floating-point value.
+ *
+ * The value is `d.ddd x 10^exp`, with the `len` ASCII digits of
+ * `digits` and no leading or trailing zero. An empty digit string is 0.
+ */
+typedef struct s_pf_dec
+{
+	char digits[PF_DEC_DIGITS];
+	int  len;
+	int  exp;
+} t_pf_dec;
+
+/**
+ * @struct s_pf_frac
+ * @brief Fraction part of a double, as `words / 2^bits`.
+ *
+ * `words` holds `count` little-endian 64-bit limbs, of which the ones
+ * below `low` are zero; the fraction is zero once `low` reaches `count`.
+ */
+typedef struct s_pf_frac
+{
+	uint64_t words[PF_FRAC_WORDS];
+	int      count;
+	int      low;
+	int      bits;
+} t_pf_frac;
+
+/**
+ * @struct s_pf_ryu
+ * @brief Working state of the shortest-digit search.
+ *
+ * `vr` is the value and `vp` / `vm` the halfway points to its
+ * neighbours, all scaled by `10^-e10`. The `*_zeros` fields record
+ * whether only zero digits were dropped from `vr` and `vm`.
+ */
+typedef struct s_pf_ryu
+{
+	uint64_t vr;
+	uint64_t vp;
+	uint64_t vm;
+	int      e10;
+	int      vr_zeros;
+	int      vm_zeros;
+	int      accept_bounds;
+} t_pf_ryu;
+
+/**
+ * @enum e_pf_sink
+ * @brief Destination of the formatted output.
+ *
+ * - `PF_SINK_FD`: `buf` is a staging buffer flushed to `fd`.
+ * - `PF_SINK_MEM`: `buf` is caller memory of `cap + 1` bytes; output that
+ *   does not fit is counted but dropped (`snprintf` semantics).
+ * - `PF_SINK_ALLOC`: `buf` is a heap block of `cap + 1` bytes that grows
+ *   as needed (`asprintf` semantics).
+ */
+typedef enum e_pf_sink
+{
+	PF_SINK_FD,
+	PF_SINK_MEM,
+	PF_SINK_ALLOC
+} t_pf_sink;
+
+struct s_pf;
+
+/**
+ * @typedef t_pf_handler
+ * @brief Formats one conversion into the output of `pf`.
+ */
+typedef void (*t_pf_handler)(t_fmt* fmt, va_list* args, struct s_pf* pf);
+
+/**
+ * @struct s_pf_spec
+ * @brief Entry of the specifier table, indexed by character.
+ *
+ * `handler` is set for conversion specifiers, `flag` for flag characters
+ * and `length` for length modifier characters.
+ */
+typedef struct s_pf_spec
+{
+	t_pf_handler handler;
+	int          flag;
+	t_pf_length  length;
+} t_pf_spec;
+
+/**
+ * @struct s_pf_op
+ * @brief One instruction of a compiled format.
+ *
+ * A literal span when `fmt.specifier` is `'\0'` (`text` and `len` point
+ * into the program's copy of the format), a conversion otherwise.
+ */
+typedef struct s_pf_op
+{
+	t_fmt       fmt;
+	const char* text;
+	size_t      len;
+} t_pf_op;
+
+/**
+ * @struct s_pf_prog
+ * @brief A format string compiled by `ft_printf_compile`.
+ *
+ * Holds the parsed conversions and the literal spans between them, so
+ * running the format again needs no parsing. The program, its
+ * instructions and its copy of the format live in a single allocation.
+ */
+typedef struct s_pf_prog
+{
+	t_pf_op* ops;
+	size_t   count;
+} t_pf_prog;
+
+/**
+ * @struct s_pf_fdbuf
+ * @brief Pending output of one file descriptor for `ft_dprintf`.
+ */
+typedef struct s_pf_fdbuf
+{
+	char*  data;
+	size_t len;
+} t_pf_fdbuf;
+
+/**
+ * @struct s_pf_fdbufs
+ * @brief Table of `ft_dprintf` buffers, indexed by file descriptor.
+ *
+ * Grows on demand, so there is no fixed limit on descriptor numbers.
+ * `lock` serializes every access to the table and its buffers.
+ * `exit_hook` is set once the first buffer exists; it is read without
+ * the lock, so calls that never used `ft_dprintf` skip it entirely.
+ * `closed` is set once the exit handler has freed the buffers. Bit `fd`
+ * of `pending` is set while descriptor `fd` has bytes waiting; it is
+ * changed under the lock but read without it, so `ft_fflush` on an
+ * empty descriptor, as `ft_printf` does, takes no lock.
+ */
+typedef struct s_pf_fdbufs
+{
+	t_pf_fdbuf*     bufs;
+	int             count;
+	int             closed;
+	atomic_int      exit_hook;
+	atomic_ullong   pending;
+	pthread_mutex_t lock;
+} t_pf_fdbufs;
+
 /**
  * @struct s_pf
  * @brief State struct for ft_printf.
  *
- * Keeps track of total characters written, and internal errors.
+ * Keeps track of total characters written, internal errors, and the
+ * output sink: its kind, its buffer and, for `PF_SINK_FD`, the file
+ * descriptor the buffer is flushed to. When `hold` is set, bytes still
+ * buffered at the end of the call are kept for a later flush; otherwise
+ * a full descriptor buffer moves to a heap block (`spilled`) so the call
+ * is written at once. If that block cannot be allocated, the buffer is
+ * written out early, or, when `must_spill` is set, the call fails with
+ * `malloc_error` instead. The format descriptor of the current conversion is
+ * embedded, so a call that fits its stack buffer needs no heap
+ * allocation.
  */
 typedef struct s_pf
 {
-	int    total;
-	int    write_error;
-	int    malloc_error;
-	t_fmt* fmt;
+	int       total;
+	int       write_error;
+	int       malloc_error;
+	t_pf_sink sink;
+	int       fd;
+	int       hold;
+	int       spilled;
+	int       must_spill;
+	char*     buf;
+	size_t    len;
+	size_t    cap;
+	t_fmt     fmt;
 } t_pf;
 
-int  ft_printf(const char* format, ...);
-int  initialize_printf_structs(t_pf* pf);
+int ft_printf(const char* format, ...);
+int ft_snprintf(char* str, size_t size, const char* format, ...);
+int ft_vsnprintf(char* str, size_t size, const char* format, va_list args);
+int ft_asprintf(char** strp, const char* format, ...);
+int ft_vasprintf(char** strp, const char* format, va_list args);
+int ft_dprintf(int fd, const char* format, ...);
+int ft_vdprintf(int fd, const char* format, va_list args);
+int ft_fflush(int fd);
+
+t_pf_prog* ft_printf_compile(const char* format);
+void       ft_printf_free_compiled(t_pf_prog* prog);
+int        ft_printf_exec(const t_pf_prog* prog, ...);
+int        ft_vprintf_exec(const t_pf_prog* prog, va_list args);
+int        ft_snprintf_exec(char* str, size_t size, const t_pf_prog* prog,
+                            ...);
+int        ft_vsnprintf_exec(char* str, size_t size, const t_pf_prog* prog,
+                             va_list args);
+
+int  ft_printf_register(char spec, t_pf_handler handler);
+void ft_printf_field(t_fmt* fmt, t_pf* pf, const char* format, ...);
+
+void initialize_printf_structs(t_pf* pf);
+int  print_to_sink(t_pf* pf, const char* format, va_list* args);
+int  finish_printf(t_pf* pf);
 void process_format_string(const char* format, va_list* args, t_pf* pf);
+void parse_and_handle_specifier(t_fmt* fmt, va_list* args, t_pf* pf);
+void exec_printf_program(const t_pf_prog* prog, va_list* args, t_pf* pf);
+
+void write_safely(char* str, t_pf* pf);
+void write_safely_len(char* str, size_t len, t_pf* pf);
+void write_char_safely(char c, t_pf* pf);
+void write_repeat_safely(char c, size_t n, t_pf* pf);
+void flush_printf_buffer(t_pf* pf);
 
-void write_safely(int fd, char* str, t_pf* pf);
-void write_safely_len(int fd, char* str, size_t len, t_pf* pf);
-void write_char_safely(int fd, char c, t_pf* pf);
+const t_pf_spec* get_printf_specs(void);
 
-int  is_valid_flag(char c);
 int  setup_format(const char** format, t_fmt* fmt);
 void print_padding(int padding, char pad_char, t_pf* pf);
 
@@ -83,23 +351,38 @@ int handle_width(t_fmt* fmt, size_t len);
 
 void format_and_print_c(t_fmt* fmt, va_list* args, t_pf* pf);
 void format_and_print_s(t_fmt* fmt, va_list* args, t_pf* pf);
-void format_and_print_percent(t_fmt* fmt, t_pf* pf);
+void format_and_print_percent(t_fmt* fmt, va_list* args, t_pf* pf);
+
+int64_t  fetch_signed_arg(t_fmt* fmt, va_list* args);
+uint64_t fetch_unsigned_arg(t_fmt* fmt, va_list* args);
 
 void format_and_print_id(t_fmt* fmt, va_list* args, t_pf* pf);
 void format_and_print_u(t_fmt* fmt, va_list* args, t_pf* pf);
-void format_and_print_x(t_fmt* fmt, va_list* args, int upper, t_pf* pf);
+void format_and_print_x(t_fmt* fmt, va_list* args, t_pf* pf);
+void format_and_print_p(t_fmt* fmt, va_list* args, t_pf* pf);
+void format_and_print_point(t_fmt* fmt, va_list* args, t_pf* pf);
+void format_and_print_dpoint(t_fmt* fmt, va_list* args, t_pf* pf);
+
+void format_and_print_f(t_fmt* fmt, va_list* args, t_pf* pf);
+void format_and_print_e(t_fmt* fmt, va_list* args, t_pf* pf);
+void format_and_print_g(t_fmt* fmt, va_list* args, t_pf* pf);
+void format_and_print_a(t_fmt* fmt, va_list* args, t_pf* pf);
 
-char* handle_precision_int(t_fmt* fmt, char* str, int* len, t_pf* pf);
-void  print_formatted_number(t_fmt* fmt, char* str, int len, t_pf* pf);
+uint64_t double_to_bits(double value);
+void     shortest_decimal(double value, t_pf_dec* dec);
+int      pow5_bits(int e);
+int      log10_pow2(int e);
 
-char* handle_precision_p(t_fmt* fmt, char* str, int* len, t_pf* pf);
-void  handle_space_flag_p(t_pf* pf, int* padding);
-void  handle_minus_flag_p(char* str, int padding, t_pf* pf);
-void  print_right_aligned_p(t_fmt* fmt, char* str, int padding, t_pf* pf);
+const uint64_t* pow5_inv_split(int i);
+const uint64_t* pow5_split(int i);
+void     float_to_decimal(double value, int precision, int fixed,
+                          t_pf_dec* dec);
 
-int   requires_alternative_form(char specifier, char* str);
-char* prepend_alternative_form(char* str, char specifier, t_pf* pf);
-int   get_alternative_form_length(char specifier);
+char* render_decimal(uint64_t value, char* end);
+char* render_unsigned(uint64_t value, unsigned int base, const char* digits,
+                      char* end);
+void  print_formatted_number(t_fmt* fmt, const char* prefix,
+                             const char* digits, int len, t_pf* pf);
 
 /** @} */ // end of ft_printf group
 
@@ -0,0 +1,194 @@
+/**
+ * @file ft_rope.h
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Rope: a balanced tree of string chunks for large editable text.
+ *
+ * @details
+ * This header declares the `t_rope` type and its operations. A rope
+ * stores a long string as a height-balanced binary tree whose leaves
+ * hold chunks of at most `ROPE_LEAF_MAX` bytes and whose internal nodes
+ * cache the total length of their subtree.
+ *
+ * Editing a rope (insert, delete, concat, split) costs O(log n) instead
+ * of the O(n) copy that `ft_strjoin` / `ft_substr` perform on a flat
+ * string. The text can be walked chunk by chunk with `ft_rope_iter`, or
+ * flattened back to a contiguous string with `ft_rope_flatten`.
+ *
+ * @note
+ * - Nodes are immutable and reference counted: an edit copies only the
+ *   nodes on the path it changes and shares the rest, so `ft_rope_concat`
+ *   does not copy its source and a failed edit leaves the rope unchanged.
+ * - Reference counts are atomic, so ropes that share nodes may be edited
+ *   and released on different threads. A single `t_rope` must still not
+ *   be used by two threads at once.
+ *
+ * @ingroup rope
+ */
+
+#ifndef FT_ROPE_H
+#define FT_ROPE_H
+
+/**
+ * @defgroup rope Rope
+ * @brief Balanced string tree with O(log n) edits.
+ *
+ * @details
+ * This group includes:
+ * - @ref ft_rope_new
+ * - @ref ft_rope_free
+ * - @ref ft_rope_len
+ * - @ref ft_rope_char_at
+ * - @ref ft_rope_insert
+ * - @ref ft_rope_delete
+ * - @ref ft_rope_concat
+ * - @ref ft_rope_split
+ * - @ref ft_rope_iter
+ * - @ref ft_rope_flatten
+ *
+ * @{
+ */
+
+/**
+ * @brief Maximum number of bytes stored in a single leaf.
+ */
+#ifndef ROPE_LEAF_MAX
+#define ROPE_LEAF_MAX 512
+#endif
+
+/**
+ * @typedef t_rope_node
+ * @brief Node of a rope tree.
+ *
+ * @details
+ * A leaf has no children and stores `len` bytes in `data`. An internal
+ * node always has two children and `len` is the length of its subtree.
+ * `height` is 1 for leaves and drives AVL-style rebalancing.
+ */
+typedef struct s_rope_node
+{
+	struct s_rope_node* left;   ///< Left subtree (NULL for leaves).
+	struct s_rope_node* right;  ///< Right subtree (NULL for leaves).
+	size_t              len;    ///< Number of bytes in this subtree.
+	atomic_size_t       refs;   ///< Number of owners of this node.
+	int                 height; ///< Height of this subtree.
+	char                data[]; ///< Leaf bytes (not null-terminated).
+} t_rope_node;
+
+/**
+ * @typedef t_rope
+ * @brief Handle to a rope.
+ *
+ * @details
+ * Holds the current root of the tree; an empty rope has a NULL root.
+ * All edits replace the root, so a handle stays valid across edits.
+ */
+typedef struct s_rope
+{
+	t_rope_node* root; ///< Root node, or NULL for an empty rope.
+} t_rope;
+
+/**
+ * @brief Creates a rope holding a copy of a string.
+ *
+ * @param s The initial content (NULL creates an empty rope).
+ * @return A new rope, or NULL on allocation failure.
+ */
+t_rope* ft_rope_new(const char* s);
+
+/**
+ * @brief Frees a rope and the nodes no other rope shares.
+ *
+ * @param rope The rope to free (NULL is ignored).
+ */
+void ft_rope_free(t_rope* rope);
+
+/**
+ * @brief Returns the number of bytes in a rope.
+ *
+ * @param rope The rope.
+ * @return Its length, or 0 if @p rope is NULL.
+ */
+size_t ft_rope_len(const t_rope* rope);
+
+/**
+ * @brief Returns the byte at a given index.
+ *
+ * @param rope  The rope.
+ * @param index Byte index.
+ * @return The byte, or `\0` if @p index is out of range.
+ */
+char ft_rope_char_at(const t_rope* rope, size_t index);
+
+/**
+ * @brief Inserts a string at a given index.
+ *
+ * @param rope  The rope to edit.
+ * @param index Insertion point (clamped to the rope length).
+ * @param s     The string to insert.
+ * @return 0 on success, -1 on allocation failure (rope unchanged).
+ */
+int ft_rope_insert(t_rope* rope, size_t index, const char* s);
+
+/**
+ * @brief Removes a range of bytes.
+ *
+ * @param rope  The rope to edit.
+ * @param index First byte to remove.
+ * @param len   Number of bytes to remove (clamped to the rope end).
+ * @return 0 on success, -1 on allocation failure (rope unchanged).
+ */
+int ft_rope_delete(t_rope* rope, size_t index, size_t len);
+
+/**
+ * @brief Appends the content of one rope to another.
+ *
+ * @param dst The rope to append to.
+ * @param src The rope to append (left unchanged, nodes are shared).
+ * @return 0 on success, -1 on allocation failure (@p dst unchanged).
+ */
+int ft_rope_concat(t_rope* dst, const t_rope* src);
+
+/**
+ * @brief Splits a rope in two at a given index.
+ *
+ * @param rope  The rope to split; keeps the bytes before @p index.
+ * @param index Split point (clamped to the rope length).
+ * @return A new rope with the bytes from @p index on, or NULL on
+ *         allocation failure (@p rope unchanged).
+ */
+t_rope* ft_rope_split(t_rope* rope, size_t index);
+
+/**
+ * @brief Calls a function on each leaf chunk, in order.
+ *
+ * @param rope The rope to walk.
+ * @param f    Called with each chunk, its length and @p ctx.
+ * @param ctx  User pointer passed through to @p f.
+ */
+void ft_rope_iter(const t_rope* rope, void (*f)(const char*, size_t, void*),
+                  void* ctx);
+
+/**
+ * @brief Copies a rope into a newly allocated contiguous string.
+ *
+ * @param rope The rope to flatten.
+ * @return A null-terminated string, or NULL on allocation failure.
+ */
+char* ft_rope_flatten(const t_rope* rope);
+
+/* ************************************************************************** */
+/*                         INTERNAL NODE OPERATIONS                           */
+/* ************************************************************************** */
+
+t_rope_node* rope_node_retain(t_rope_node* n);
+void         rope_node_release(t_rope_node* n);
+t_rope_node* rope_leaf_new(const char* s, size_t len);
+int          rope_node_join(t_rope_node* l, t_rope_node* r, t_rope_node** out);
+int          rope_node_split(t_rope_node* n, size_t index, t_rope_node** left,
+                             t_rope_node** right);
+int          rope_node_build(const char* s, size_t len, t_rope_node** out);
+
+/** @} */ // end of rope group
+
+#endif
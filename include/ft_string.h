@@ -18,16 +18,31 @@
 #ifndef FT_STRING_H
 #define FT_STRING_H
 
+/**
+ * @brief Builds a function without AddressSanitizer checks.
+ *
+ * For block kernels that deliberately read whole aligned blocks past a
+ * string's terminating `\0`: the reads never leave the page, but ASan
+ * would report them as overflows.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define FT_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define FT_NO_ASAN
+#endif
+
 /**
  * @defgroup string_utils String Manipulation Utilities
  * @brief Functions for handling and manipulating C strings.
  *
  * @details
  * This group includes common string operations such as copying,
- * concatenation, trimming, splitting, searching, and case conversion.
+ * concatenation, trimming, splitting, searching, and case conversion
+ * (per character or in bulk over a whole buffer).
  *
  * Useful for tasks like:
  * - Extracting substrings
+ * - Validating and measuring UTF-8 text by codepoint
  * - Skipping whitespace
  * - Finding characters or substrings
  * - Transforming string content
@@ -35,28 +50,39 @@
  * @{
  */
 
+char*  ft_strarr_join(char** arr, const char* sep);
+int    ft_strcasecmp(const char* s1, const char* s2);
 char*  ft_strcat(char* dest, const char* src);
 char** ft_split_charset(char* s, char* charset);
 char** ft_split(const char* s, char c);
 char*  ft_strchr(const char* str, int c);
 char*  ft_strcpy(char* dst, const char* src);
 char*  ft_strdup(const char* src);
+char*  ft_strdup_len(const char* src, size_t len);
 void   ft_striteri(char* s, void (*f)(unsigned int, char*));
 char*  ft_strjoin(const char* s1, const char* s2);
 char*  ft_strjoin_and_free(char* s1, char* s2, int free_s1, int free_s2);
+char*  ft_strjoin_n(size_t count, ...);
 size_t ft_strlcat(char* dest, const char* src, size_t size);
 size_t ft_strlcpy(char* dest, const char* src, size_t size);
 size_t ft_strlen(const char* str);
 char*  ft_strmapi(char const* s, char (*f)(unsigned int, char));
+int    ft_strncasecmp(const char* s1, const char* s2, size_t n);
 int    ft_strcmp(const char* s1, const char* s2);
 int    ft_strncmp(const char* s1, const char* s2, size_t n);
 char*  ft_strndup(const char* src, size_t n);
+size_t ft_strnlen(const char* str, size_t maxlen);
 char*  ft_strnstr(const char* big, const char* little, size_t len);
 char*  ft_strrchr(const char* str, int c);
+char*  ft_str_tolower_inplace(char* s);
+char*  ft_str_toupper_inplace(char* s);
 char*  ft_strtrim(const char* s1, const char* set);
 char*  ft_substr(const char* s, unsigned int start, size_t len);
 int    ft_tolower(int c);
 int    ft_toupper(int c);
+size_t ft_utf8_strlen(const char* s);
+char*  ft_utf8_substr(const char* s, size_t start, size_t len);
+bool   ft_utf8_validate(const char* s, size_t len);
 void   skip_whitespace_index(const char* input, int* i);
 char*  skip_whitespace_ptr(const char* s);
 
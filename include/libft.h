@@ -11,7 +11,8 @@
  *
  * These features include memory and string manipulation, character
  * classification, formatted output, mathematical operations, dynamic
- * arrays, matrix utilities, and more.
+ * arrays, matrix utilities, ropes for large editable text, an
+ * asynchronous logger, and more.
  *
  * This header allows external programs to access the entire libft
  * functionality through a single include.
@@ -21,18 +22,21 @@
 #ifndef LIBFT_H
 #define LIBFT_H
 
-#include <errno.h>    /* errno, EINTR, etc. */
-#include <fcntl.h>    /* open, close, file control */
-#include <limits.h>   /* INT_MAX, LLONG_MAX, etc. */
-#include <math.h>     /* floor, sqrt, pow, etc. */
-#include <stdarg.h>   /* va_list for ft_printf */
-#include <stdbool.h>  /* bool type (C99) */
-#include <stdint.h>   /* uint64_t, etc. */
-#include <stdio.h>    /* perror, printf for debugging */
-#include <stdlib.h>   /* malloc, free, exit, etc. */
-#include <string.h>   /* to be able to use it in other projects */
-#include <sys/time.h> /* gettimeofday for ft_rand */
-#include <unistd.h>   /* write, read, close, etc. */
+#include <errno.h>     /* errno, EINTR, etc. */
+#include <fcntl.h>     /* open, close, file control */
+#include <limits.h>    /* INT_MAX, LLONG_MAX, etc. */
+#include <math.h>      /* floor, sqrt, pow, etc. */
+#include <pthread.h>   /* pthread_mutex_t for ft_dprintf */
+#include <stdarg.h>    /* va_list for ft_printf */
+#include <stdatomic.h> /* atomic_int */
+#include <stdbool.h>   /* bool type (C99) */
+#include <stddef.h>    /* ptrdiff_t, size_t */
+#include <stdint.h>    /* uint64_t, etc. */
+#include <stdio.h>     /* perror, printf for debugging */
+#include <stdlib.h>    /* malloc, free, exit, etc. */
+#include <string.h>    /* to be able to use it in other projects */
+#include <sys/time.h>  /* gettimeofday for ft_rand */
+#include <unistd.h>    /* write, read, close, etc. */
 
 /* --- Libft module headers --- */
 #include "ft_2darray.h"
@@ -41,10 +45,12 @@
 #include "ft_convert.h"
 #include "ft_file.h"
 #include "ft_list.h"
+#include "ft_log.h"
 #include "ft_math.h"
 #include "ft_memory.h"
 #include "ft_output.h"
 #include "ft_printf.h"
+#include "ft_rope.h"
 #include "ft_sorting.h"
 #include "ft_string.h"
 #include "ft_utils.h"
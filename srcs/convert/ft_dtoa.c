@@ -0,0 +1,131 @@
+/**
+ * @file ft_dtoa.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Shortest round-trip conversion of a double to a string.
+ *
+ * @details
+ * `ft_dtoa` prints the fewest significant digits that read back as the
+ * same double, using the Ryu digits computed by `shortest_decimal`.
+ * The notation follows `%.17g`: fixed for decimal exponents in [-4, 17),
+ * scientific otherwise, never with trailing zeros.
+ *
+ * @ingroup number_conversions
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Size of the stack buffer `ft_dtoa` formats into.
+ *
+ * A sign, 17 digits, a point, up to four leading zeros or a 5-byte
+ * exponent, and the terminator.
+ */
+#define DTOA_BUF_SIZE 32
+
+/**
+ * @internal
+ * @brief Writes @p dec in fixed notation at @p out; returns the length.
+ */
+static size_t dtoa_fixed(const t_pf_dec* dec, char* out)
+{
+	size_t len;
+	int    i;
+
+	len = 0;
+	if (dec->exp < 0)
+	{
+		out[len++] = '0';
+		out[len++] = '.';
+		i          = -1;
+		while (i-- > dec->exp)
+			out[len++] = '0';
+		ft_memcpy(out + len, dec->digits, dec->len);
+		return (len + dec->len);
+	}
+	i = 0;
+	while (i <= dec->exp)
+	{
+		out[len++] = (i < dec->len) ? dec->digits[i] : '0';
+		i++;
+	}
+	if (dec->len > dec->exp + 1)
+	{
+		out[len++] = '.';
+		ft_memcpy(out + len, dec->digits + i, dec->len - i);
+		len += dec->len - i;
+	}
+	return (len);
+}
+
+/**
+ * @internal
+ * @brief Writes @p dec in scientific notation at @p out; returns the
+ *        length.
+ */
+static size_t dtoa_scientific(const t_pf_dec* dec, char* out)
+{
+	size_t len;
+	int    exp;
+
+	len        = 0;
+	out[len++] = dec->digits[0];
+	if (dec->len > 1)
+	{
+		out[len++] = '.';
+		ft_memcpy(out + len, dec->digits + 1, dec->len - 1);
+		len += dec->len - 1;
+	}
+	out[len++] = 'e';
+	out[len++] = (dec->exp < 0) ? '-' : '+';
+	exp        = (dec->exp < 0) ? -dec->exp : dec->exp;
+	if (exp >= 100)
+		out[len++] = '0' + exp / 100;
+	out[len++] = '0' + exp / 10 % 10;
+	out[len++] = '0' + exp % 10;
+	return (len);
+}
+
+/**
+ * @brief Converts a double to its shortest round-trip string.
+ *
+ * @details
+ * The result has the fewest significant digits that `strtod` reads back
+ * as exactly @p n; among those, the closest to @p n. It uses fixed
+ * notation when the decimal exponent is in [-4, 17) and `%e` notation
+ * otherwise, for example `"0.1"`, `"123.456"`, `"1e+17"` or
+ * `"5e-324"`. Zero keeps its sign (`"-0"`), and non-finite values give
+ * `"inf"`, `"-inf"` or `"nan"`.
+ *
+ * @param n The value to convert.
+ *
+ * @return A newly allocated string, or NULL on allocation failure.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ *
+ * @see shortest_decimal
+ * @ingroup number_conversions
+ */
+char* ft_dtoa(double n)
+{
+	t_pf_dec dec;
+	char     buf[DTOA_BUF_SIZE];
+	size_t   len;
+
+	if (n != n)
+		return (ft_strdup("nan"));
+	if (n - n != 0)
+		return (ft_strdup((n < 0) ? "-inf" : "inf"));
+	len = 0;
+	if (double_to_bits(n) >> 63)
+		buf[len++] = '-';
+	shortest_decimal(n, &dec);
+	if (dec.len == 0)
+		buf[len++] = '0';
+	else if (dec.exp < -4 || dec.exp >= 17)
+		len += dtoa_scientific(&dec, buf + len);
+	else
+		len += dtoa_fixed(&dec, buf + len);
+	buf[len] = '\0';
+	return (ft_strdup(buf));
+}
@@ -7,10 +7,17 @@
  * @details
  * This file implements `get_next_line`, a utility that reads from a file
  * descriptor and returns the next line of input (including `\n` if present).
- * It uses a static buffer indexed by file descriptor to support reading
- * from multiple files simultaneously.
+ * It uses a static hash table of line readers keyed by file descriptor to
+ * support reading from multiple files simultaneously. The table holds a
+ * reader only for descriptors with pending input, and its size follows
+ * their number, whatever the descriptors: a reader is freed at end of
+ * file, on error, or by `ft_gnl_release` when the caller stops reading
+ * early.
  *
- * @note `BUFFER_SIZE` and `MAX_FD` are defined in ft_file.h.
+ * The static table makes `get_next_line` unsafe to call from several
+ * threads; threads should use their own `t_linereader` instead.
+ *
+ * @note `BUFFER_SIZE` is defined in ft_file.h.
  *
  * @ingroup file_utils
  */
@@ -18,121 +25,190 @@
 #include "libft.h"
 
 /**
- * @brief Reads from a file descriptor and appends to the remainder buffer.
+ * @brief Returns the process-wide table of `get_next_line` readers.
  *
- * @details
- * Allocates a temporary buffer and appends read data to the remainder until
- * a newline is found or EOF is reached. It handles reallocation and joins
- * partial strings dynamically.
+ * @ingroup file_utils
+ */
+static t_gnl_table* gnl_table(void)
+{
+	static t_gnl_table table;
+
+	return (&table);
+}
+
+/**
+ * @brief Returns the slot of a descriptor's reader, or the empty slot it
+ *        would go to.
  *
- * @param fd         The file descriptor to read from.
- * @param remainder  Pointer to the pointer holding current remainder.
+ * @param table The reader table (with at least one slot).
+ * @param fd The file descriptor.
  *
- * @return Number of bytes read on success, -1 on error.
+ * @return The slot index.
  *
- * @see ft_strdup
- * @see ft_strchr
- * @see ft_strjoin
  * @ingroup file_utils
  */
-static ssize_t read_and_store(int fd, char** remainder)
+static int find_slot(t_gnl_table* table, int fd)
 {
-	ssize_t bytes_read;
-	char*   buffer;
-	char*   new_remainder;
-
-	if (*remainder == NULL)
-		*remainder = ft_strdup("");
-	buffer = malloc(BUFFER_SIZE + 1);
-	if (!buffer)
+	int mask;
+	int slot;
+
+	mask = table->count - 1;
+	slot = fd & mask;
+	while (table->readers[slot] && table->readers[slot]->fd != fd)
+		slot = (slot + 1) & mask;
+	return (slot);
+}
+
+/**
+ * @brief Moves the readers to a table of `count` slots.
+ *
+ * @param table The reader table.
+ * @param count The new number of slots, a power of two larger than
+ *              `active`.
+ *
+ * @return 0 on success, -1 on allocation failure (the table is left
+ *         unchanged).
+ *
+ * @ingroup file_utils
+ */
+static int resize_table(t_gnl_table* table, int count)
+{
+	t_gnl_table resized;
+	int         slot;
+
+	resized.readers = ft_calloc(count, sizeof(t_linereader*));
+	if (!resized.readers)
 		return (-1);
-	bytes_read = 1;
-	while ((ft_strchr(*remainder, '\n') == NULL) && bytes_read != 0)
+	resized.count  = count;
+	resized.active = table->active;
+	slot           = 0;
+	while (slot < table->count)
 	{
-		bytes_read = read(fd, buffer, BUFFER_SIZE);
-		if (bytes_read == -1)
-			return (free(buffer), -1);
-		buffer[bytes_read] = '\0';
-		new_remainder      = ft_strjoin(*remainder, buffer);
-		if (!new_remainder)
-			return (free(buffer), -1);
-		free(*remainder);
-		*remainder = new_remainder;
+		if (table->readers[slot])
+			resized.readers[find_slot(&resized, table->readers[slot]->fd)] =
+			    table->readers[slot];
+		slot++;
 	}
-	free(buffer);
-	return (bytes_read);
+	free(table->readers);
+	*table = resized;
+	return (0);
 }
 
 /**
- * @brief Extracts the next line from the remainder buffer.
+ * @brief Refills the slot a reader was removed from.
  *
  * @details
- * Allocates and returns a new string containing everything from the start
- * of `remainder` up to and including the first newline, or up to the null
- * terminator if no newline is found.
+ * Readers further along the same probe run move back into the gap when
+ * their home slot allows it, so lookups never stop early at an empty
+ * slot and no tombstones are needed.
  *
- * @param remainder The remainder buffer.
- * @return New allocated line string, or NULL if empty.
+ * @param table The reader table.
+ * @param gap The slot just emptied.
  *
- * @see ft_substr
  * @ingroup file_utils
  */
-static char* extract_line(char* remainder)
+static void close_gap(t_gnl_table* table, int gap)
 {
-	size_t line_len;
-	char*  line;
+	int mask;
+	int slot;
+	int home;
 
-	line_len = 0;
-	if (!remainder || !remainder[0])
-		return (NULL);
-	while (remainder[line_len] && remainder[line_len] != '\n')
-		line_len++;
-	if (remainder[line_len] == '\n')
-		line_len++;
-	line = ft_substr(remainder, 0, line_len);
-	if (!line)
-		return (NULL);
-	return (line);
+	mask = table->count - 1;
+	slot = (gap + 1) & mask;
+	while (table->readers[slot])
+	{
+		home = table->readers[slot]->fd & mask;
+		if (((slot - home) & mask) >= ((slot - gap) & mask))
+		{
+			table->readers[gap]  = table->readers[slot];
+			table->readers[slot] = NULL;
+			gap                  = slot;
+		}
+		slot = (slot + 1) & mask;
+	}
 }
 
 /**
- * @brief Updates the remainder buffer after a line has been extracted.
+ * @brief Returns the reader of a descriptor, creating it if needed.
  *
  * @details
- * Frees the old remainder and returns a newly allocated string containing
- * the part of the original string after the first newline.
+ * A new reader is allocated before the table grows (doubling once it
+ * would be more than half full), so a failure leaves the table as it
+ * was. The reader uses `read`, so `get_next_line` advances the
+ * descriptor's offset like it always has.
+ *
+ * @param table The reader table.
+ * @param fd The file descriptor.
  *
- * @param remainder The buffer to update.
- * @return A new remainder string, or NULL if nothing is left.
+ * @return The descriptor's reader, or NULL on allocation failure.
  *
- * @see ft_strlen
- * @see ft_substr
+ * @see resize_table
  * @ingroup file_utils
  */
-static char* update_remainder(char* remainder)
+static t_linereader* get_reader(t_gnl_table* table, int fd)
 {
-	char*  new_remainder;
-	size_t line_len;
-	size_t remainder_len;
+	t_linereader* reader;
+	int           count;
 
-	if (!remainder)
+	if (table->count > 0)
+	{
+		reader = table->readers[find_slot(table, fd)];
+		if (reader)
+			return (reader);
+	}
+	reader = malloc(sizeof(t_linereader));
+	if (!reader)
 		return (NULL);
-	line_len = 0;
-	while (remainder[line_len] && remainder[line_len] != '\n')
-		line_len++;
-	if (remainder[line_len] == '\n')
-		line_len++;
-	if (remainder[line_len] == '\0')
+	count = (table->count > 0) ? table->count * 2 : GNL_TABLE_MIN;
+	if ((table->active + 1) * 2 > table->count
+	    && resize_table(table, count) == -1)
 	{
-		free(remainder);
+		free(reader);
 		return (NULL);
 	}
-	remainder_len = ft_strlen(remainder);
-	new_remainder = ft_substr(remainder, line_len, remainder_len - line_len);
-	free(remainder);
-	if (!new_remainder)
+	ft_linereader_init(reader, fd, BUFFER_SIZE);
+	reader->offset = -1;
+	table->readers[find_slot(table, fd)] = reader;
+	table->active++;
+	return (reader);
+}
+
+/**
+ * @brief Reads the next line from a file descriptor, with its length.
+ *
+ * @details
+ * Shares the per-descriptor readers of `get_next_line`, so the two can
+ * be mixed on one descriptor. The length makes lines holding NUL bytes
+ * usable.
+ *
+ * @param fd The file descriptor to read from.
+ * @param len Receives the length of the line, newline included (may be
+ *            NULL; 0 when no line is returned).
+ * @return The next line, null-terminated, or NULL if EOF or an error
+ *         occurs.
+ *
+ * @note Caller is responsible for freeing the returned string.
+ *
+ * @see get_next_line
+ * @see linereader_copy_line
+ * @ingroup file_utils
+ */
+char* ft_getline(int fd, size_t* len)
+{
+	t_linereader* reader;
+	char*         line;
+
+	if (len)
+		*len = 0;
+	if (fd < 0 || BUFFER_SIZE <= 0)
+		return (NULL);
+	reader = get_reader(gnl_table(), fd);
+	if (!reader)
 		return (NULL);
-	return (new_remainder);
+	line = linereader_copy_line(reader, len);
+	if (!line)
+		ft_gnl_release(fd);
+	return (line);
 }
 
 /**
@@ -140,43 +216,89 @@ static char* update_remainder(char* remainder)
  *
  * @details
  * This function returns the next line read from `fd`. It uses static storage
- * to preserve context across calls and handles files independently.
+ * to preserve context across calls and handles files independently. Reads
+ * interrupted by a signal are retried. The reader of a descriptor is freed
+ * once it reaches end of file or fails; call `ft_gnl_release` to free it
+ * before that.
  *
  * @param fd The file descriptor to read from.
  * @return The next line, or NULL if EOF or an error occurs.
  *
  * @note Caller is responsible for freeing the returned string.
- * @note Depends on BUFFER_SIZE and MAX_FD being defined.
+ * @note Depends on BUFFER_SIZE being defined.
  *
- * @see read_and_store
- * @see extract_line
- * @see update_remainder
+ * @see ft_gnl_release
+ * @see ft_getline
  * @ingroup file_utils
  */
 char* get_next_line(int fd)
 {
-	static char* remainder[MAX_FD];
-	char*        line;
-	ssize_t      bytes_read;
+	return (ft_getline(fd, NULL));
+}
 
-	if (fd < 0 || BUFFER_SIZE <= 0 || fd >= MAX_FD)
-		return (NULL);
-	if (!remainder[fd])
+/**
+ * @brief Frees the pending input `get_next_line` keeps for a descriptor.
+ *
+ * @details
+ * The next `get_next_line(fd)` starts from whatever `fd` reads next.
+ * The table shrinks by half once it is eight times larger than the
+ * readers left, and releasing the last reader frees it, so a process
+ * that is done reading holds no memory for it.
+ *
+ * @param fd The file descriptor, typically about to be closed.
+ *
+ * @see ft_gnl_release_all
+ * @ingroup file_utils
+ */
+void ft_gnl_release(int fd)
+{
+	t_gnl_table* table;
+	int          slot;
+
+	table = gnl_table();
+	if (fd < 0 || table->count == 0)
+		return;
+	slot = find_slot(table, fd);
+	if (!table->readers[slot])
+		return;
+	ft_linereader_destroy(table->readers[slot]);
+	free(table->readers[slot]);
+	table->readers[slot] = NULL;
+	table->active--;
+	if (table->active == 0)
 	{
-		remainder[fd] = ft_strdup("");
-		if (!remainder[fd])
-			return (NULL);
+		free(table->readers);
+		table->readers = NULL;
+		table->count   = 0;
+		return;
 	}
-	bytes_read = read_and_store(fd, &remainder[fd]);
-	if (bytes_read == -1 || (bytes_read == 0 && remainder[fd][0] == '\0'))
+	close_gap(table, slot);
+	if (table->count > GNL_TABLE_MIN && table->active * 8 <= table->count)
+		resize_table(table, table->count / 2);
+}
+
+/**
+ * @brief Frees the pending input of every descriptor, and the table.
+ *
+ * @see ft_gnl_release
+ * @ingroup file_utils
+ */
+void ft_gnl_release_all(void)
+{
+	t_gnl_table* table;
+	int          slot;
+
+	table = gnl_table();
+	slot  = table->count;
+	while (slot-- > 0)
 	{
-		free(remainder[fd]);
-		remainder[fd] = NULL;
-		return (NULL);
+		if (!table->readers[slot])
+			continue;
+		ft_linereader_destroy(table->readers[slot]);
+		free(table->readers[slot]);
 	}
-	line = extract_line(remainder[fd]);
-	if (!line)
-		return (NULL);
-	remainder[fd] = update_remainder(remainder[fd]);
-	return (line);
+	free(table->readers);
+	table->readers = NULL;
+	table->count   = 0;
+	table->active  = 0;
 }
@@ -0,0 +1,315 @@
+/**
+ * @file linereader.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Reentrant line reader over a file descriptor.
+ *
+ * @details
+ * A `t_linereader` is a caller-owned line reader. It keeps its pending
+ * input in one growable buffer with cursors:
+ * - `read` appends straight after the pending bytes, with no join
+ * - only the bytes read since the last search are scanned for `\n`
+ * - a line is copied once, from the buffer into the returned string;
+ *   the rest stays where it is, behind the `start` cursor
+ * - the pending bytes move to the front of the buffer, or to a buffer
+ *   twice as large, only when there is no room left to read into
+ *
+ * Reading a file therefore costs time linear in its size, whatever the
+ * line lengths. The reader touches no global state, so any number of
+ * threads can each use their own. On a regular file it reads with
+ * `pread` from a position of its own, so two readers over the same
+ * descriptor each see the whole file. `get_next_line` is built on it.
+ *
+ * @ingroup file_utils
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Prepares a line reader over a file descriptor.
+ *
+ * @details
+ * No memory is allocated until the first line is read. On a seekable
+ * descriptor, reading starts at its current offset, which the reader
+ * then leaves untouched.
+ *
+ * @param reader The reader to initialize.
+ * @param fd The file descriptor to read from.
+ * @param read_size Bytes asked for by each `read` (0 for `BUFFER_SIZE`).
+ *
+ * @return 0 on success, -1 if `reader` is NULL or `fd` is negative.
+ *
+ * @see ft_linereader_destroy
+ * @ingroup file_utils
+ */
+int ft_linereader_init(t_linereader* reader, int fd, size_t read_size)
+{
+	if (!reader || fd < 0)
+		return (-1);
+	ft_bzero(reader, sizeof(t_linereader));
+	reader->fd        = fd;
+	reader->offset    = lseek(fd, 0, SEEK_CUR);
+	reader->read_size = (read_size > 0) ? read_size : BUFFER_SIZE;
+	return (0);
+}
+
+/**
+ * @brief Frees the buffer of a reader, leaving its descriptor open.
+ *
+ * @details
+ * Pending input is dropped. The reader can be used again and resumes
+ * after the input it had already read.
+ *
+ * @param reader The reader (NULL is ignored).
+ *
+ * @ingroup file_utils
+ */
+void ft_linereader_destroy(t_linereader* reader)
+{
+	if (!reader)
+		return;
+	free(reader->data);
+	reader->data    = NULL;
+	reader->start   = 0;
+	reader->scanned = 0;
+	reader->end     = 0;
+	reader->cap     = 0;
+}
+
+/**
+ * @brief Makes room for at least `read_size` bytes after `end`.
+ *
+ * @details
+ * The pending bytes are moved to the front when that frees enough room,
+ * and to a new buffer of at least twice the capacity otherwise, so the
+ * total cost of the moves stays linear in the input.
+ *
+ * @param reader The reader.
+ *
+ * @return 0 on success, -1 if allocation fails.
+ *
+ * @see ft_memmove
+ * @ingroup file_utils
+ */
+static int make_room(t_linereader* reader)
+{
+	size_t pending;
+	size_t new_cap;
+	char*  new_data;
+
+	if (reader->cap - reader->end >= reader->read_size)
+		return (0);
+	pending = reader->end - reader->start;
+	if (pending + reader->read_size <= reader->cap)
+		ft_memmove(reader->data, reader->data + reader->start, pending);
+	else
+	{
+		new_cap = reader->cap * 2;
+		if (new_cap < pending + reader->read_size)
+			new_cap = pending + reader->read_size;
+		new_data = malloc(new_cap);
+		if (!new_data)
+			return (-1);
+		if (pending > 0)
+			ft_memcpy(new_data, reader->data + reader->start, pending);
+		free(reader->data);
+		reader->data = new_data;
+		reader->cap  = new_cap;
+	}
+	reader->scanned -= reader->start;
+	reader->end   = pending;
+	reader->start = 0;
+	return (0);
+}
+
+/**
+ * @brief Reads the next chunk into the buffer, after `end`.
+ *
+ * @details
+ * Uses `pread` at the reader's own offset when it has one, and `read`
+ * otherwise. Retries reads interrupted by a signal.
+ *
+ * @param reader The reader.
+ *
+ * @return The number of bytes read, 0 at end of file, or -1 on error.
+ *
+ * @ingroup file_utils
+ */
+static ssize_t fill_buffer(t_linereader* reader)
+{
+	ssize_t bytes_read;
+
+	bytes_read = -1;
+	while (bytes_read == -1)
+	{
+		if (reader->offset >= 0)
+			bytes_read = pread(reader->fd, reader->data + reader->end,
+			                   reader->cap - reader->end, reader->offset);
+		else
+			bytes_read = read(reader->fd, reader->data + reader->end,
+			                  reader->cap - reader->end);
+		if (bytes_read == -1 && errno != EINTR)
+			return (-1);
+	}
+	if (reader->offset >= 0)
+		reader->offset += bytes_read;
+	reader->end += bytes_read;
+	return (bytes_read);
+}
+
+/**
+ * @brief Finds the next line among the pending bytes, reading as needed.
+ *
+ * @details
+ * The line is `len` bytes from `start`, its `\n` included. At end of
+ * file, the bytes left over without a `\n` form the last line. The
+ * cursors are not moved past the line. `error` is cleared first, so an
+ * earlier failure, such as a line that could not be copied, does not
+ * turn a later end of file into an error.
+ *
+ * @param reader The reader.
+ * @param len Receives the length of the line.
+ *
+ * @return 1 if a line was found, 0 at end of file, or -1 on error
+ *         (`error` is set).
+ *
+ * @see make_room
+ * @see fill_buffer
+ * @ingroup file_utils
+ */
+static int find_line(t_linereader* reader, size_t* len)
+{
+	char*   newline;
+	ssize_t bytes_read;
+
+	reader->error = 0;
+	while (1)
+	{
+		newline = NULL;
+		if (reader->end > reader->scanned)
+			newline = ft_memchr(reader->data + reader->scanned, '\n',
+			                    reader->end - reader->scanned);
+		if (newline)
+		{
+			*len = newline - (reader->data + reader->start) + 1;
+			return (1);
+		}
+		reader->scanned = reader->end;
+		bytes_read      = -1;
+		if (make_room(reader) == 0)
+			bytes_read = fill_buffer(reader);
+		if (bytes_read == -1)
+			reader->error = 1;
+		if (bytes_read <= 0)
+			break;
+	}
+	*len = reader->end - reader->start;
+	if (!reader->error && *len > 0)
+		return (1);
+	return ((reader->error) ? -1 : 0);
+}
+
+/**
+ * @brief Returns the next line of a reader as a view into its buffer.
+ *
+ * @details
+ * No copy and no allocation: `*line` points at the line inside the
+ * reader's buffer, and stays valid until the next call on the reader
+ * (or `ft_linereader_destroy`). The line includes its `\n`, except for
+ * a last line the file does not end with, and is not null-terminated;
+ * it may hold NUL bytes. At end of file or after an error the buffer is
+ * freed, so a reader that has been read to the end holds no memory.
+ *
+ * @param reader The reader.
+ * @param line Receives the start of the line (NULL when there is none).
+ * @param len Receives the length of the line (0 when there is none).
+ *
+ * @return 1 if a line was returned, 0 at end of file, or -1 on error.
+ *
+ * @see find_line
+ * @ingroup file_utils
+ */
+int ft_getline_view(t_linereader* reader, const char** line, size_t* len)
+{
+	int status;
+
+	*line = NULL;
+	*len  = 0;
+	if (!reader)
+		return (-1);
+	status = find_line(reader, len);
+	if (status != 1)
+	{
+		*len = 0;
+		ft_linereader_destroy(reader);
+		return (status);
+	}
+	*line = reader->data + reader->start;
+	reader->start += *len;
+	reader->scanned = reader->start;
+	return (1);
+}
+
+/**
+ * @brief Returns the next line of a reader as a new string.
+ *
+ * @details
+ * Like `ft_getline_view`, plus one copy into a null-terminated string.
+ * If that allocation fails, the line is left in the reader and `error`
+ * is set.
+ *
+ * @param reader The reader.
+ * @param len Receives the length of the line (may be NULL).
+ *
+ * @return A newly allocated line, or NULL at end of file or on error.
+ *
+ * @see ft_getline_view
+ * @ingroup file_utils
+ */
+char* linereader_copy_line(t_linereader* reader, size_t* len)
+{
+	const char* view;
+	size_t      size;
+	char*       line;
+
+	if (len)
+		*len = 0;
+	if (ft_getline_view(reader, &view, &size) != 1)
+		return (NULL);
+	line = malloc(size + 1);
+	if (!line)
+	{
+		reader->start -= size;
+		reader->scanned = reader->start;
+		reader->error   = 1;
+		return (NULL);
+	}
+	ft_memcpy(line, view, size);
+	line[size] = '\0';
+	if (len)
+		*len = size;
+	return (line);
+}
+
+/**
+ * @brief Returns the next line of a reader.
+ *
+ * @details
+ * The line includes its `\n`, except for a last line the file does not
+ * end with. At end of file or after an error (`error` is set then) the
+ * buffer is freed, so a reader that has been read to the end holds no
+ * memory.
+ *
+ * @param reader The reader.
+ *
+ * @return A newly allocated line, or NULL at end of file or on error.
+ *
+ * @note Caller is responsible for freeing the returned string.
+ *
+ * @see linereader_copy_line
+ * @ingroup file_utils
+ */
+char* ft_linereader_next(t_linereader* reader)
+{
+	return (linereader_copy_line(reader, NULL));
+}
@@ -0,0 +1,207 @@
+/**
+ * @file mmap_lines.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Line iterator over a memory-mapped file.
+ *
+ * @details
+ * A `t_mmap_lines` returns the lines of a regular file as views straight
+ * into a read-only mapping of it: no `read`, no copy, no allocation per
+ * line. The file is mapped one window at a time, advised with
+ * `MADV_SEQUENTIAL`, and the window slides forward as lines are
+ * consumed, so files larger than memory are read with a bounded address
+ * space. A line longer than the window doubles the window until it fits.
+ *
+ * Newlines are found with `ft_memchr`, which compares whole blocks at a
+ * time. Bytes already searched are not searched again when the window
+ * slides over a long line.
+ *
+ * Pipes, sockets, terminals and files that cannot be mapped are read
+ * through a `t_linereader` instead, behind the same calls.
+ *
+ * @ingroup file_utils
+ */
+
+#include "libft.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Unmaps the current window, if any.
+ *
+ * @param lines The iterator.
+ *
+ * @ingroup file_utils
+ */
+static void unmap_window(t_mmap_lines* lines)
+{
+	if (lines->map)
+		munmap(lines->map, lines->map_len);
+	lines->map     = NULL;
+	lines->map_len = 0;
+}
+
+/**
+ * @brief Maps the window starting at the page that holds `offset`.
+ *
+ * @details
+ * The window covers `window` bytes, or up to the end of the file.
+ *
+ * @param lines The iterator.
+ * @param offset File offset the window must contain.
+ *
+ * @return 0 on success, -1 if `mmap` fails (`error` is set).
+ *
+ * @ingroup file_utils
+ */
+static int map_window(t_mmap_lines* lines, off_t offset)
+{
+	off_t base;
+	void* map;
+
+	unmap_window(lines);
+	base = offset - offset % sysconf(_SC_PAGESIZE);
+	lines->map_len = lines->window;
+	if ((off_t) lines->map_len > lines->size - base)
+		lines->map_len = lines->size - base;
+	map = mmap(NULL, lines->map_len, PROT_READ, MAP_PRIVATE, lines->fd, base);
+	if (map == MAP_FAILED)
+	{
+		lines->map_len = 0;
+		lines->error   = 1;
+		return (-1);
+	}
+	madvise(map, lines->map_len, MADV_SEQUENTIAL);
+	lines->map  = map;
+	lines->base = base;
+	return (0);
+}
+
+/**
+ * @brief Prepares a line iterator over a file descriptor.
+ *
+ * @details
+ * A regular file is mapped from its current offset, which the iterator
+ * leaves untouched. Any other descriptor, or a file whose first window
+ * cannot be mapped, is read with a `t_linereader` asking for
+ * `MMAP_LINES_READ_SIZE` bytes at a time; `size` is -1 then.
+ *
+ * @param lines The iterator to initialize.
+ * @param fd The file descriptor to read from.
+ * @param window Bytes mapped at a time, rounded up to whole pages (0 for
+ *               `MMAP_LINES_WINDOW`).
+ *
+ * @return 0 on success, -1 if `lines` is NULL, `fd` is negative or
+ *         `fstat` fails.
+ *
+ * @see ft_mmap_lines_close
+ * @ingroup file_utils
+ */
+int ft_mmap_lines_open(t_mmap_lines* lines, int fd, size_t window)
+{
+	struct stat st;
+	size_t      page;
+
+	if (!lines || fd < 0 || fstat(fd, &st) == -1)
+		return (-1);
+	ft_bzero(lines, sizeof(t_mmap_lines));
+	lines->fd   = fd;
+	lines->size = -1;
+	page        = sysconf(_SC_PAGESIZE);
+	if (window == 0)
+		window = MMAP_LINES_WINDOW;
+	lines->window = (window + page - 1) / page * page;
+	lines->pos    = lseek(fd, 0, SEEK_CUR);
+	if (S_ISREG(st.st_mode) && lines->pos >= 0)
+	{
+		lines->size = st.st_size;
+		if (lines->pos >= lines->size || map_window(lines, lines->pos) == 0)
+			return (0);
+		lines->size  = -1;
+		lines->error = 0;
+	}
+	return (ft_linereader_init(&lines->reader, fd, MMAP_LINES_READ_SIZE));
+}
+
+/**
+ * @brief Returns the next line of a file as a view.
+ *
+ * @details
+ * `*line` points into the mapping (or the fallback reader's buffer) and
+ * stays valid until the next call or `ft_mmap_lines_close`. The line
+ * includes its `\n`, except for a last line the file does not end with,
+ * and is not null-terminated; it may hold NUL bytes.
+ *
+ * When the window ends before the line does, the window slides to the
+ * page holding the start of the line; if it already starts there, it
+ * doubles instead. The search resumes where it stopped. The window is
+ * unmapped at end of file.
+ *
+ * @param lines The iterator.
+ * @param line Receives the start of the line (NULL when there is none).
+ * @param len Receives the length of the line (0 when there is none).
+ *
+ * @return 1 if a line was returned, 0 at end of file, or -1 on error.
+ *
+ * @see ft_getline_view
+ * @ingroup file_utils
+ */
+int ft_mmap_lines_next(t_mmap_lines* lines, const char** line, size_t* len)
+{
+	const char* newline;
+	off_t       scan;
+	off_t       end;
+	off_t       page;
+
+	*line = NULL;
+	*len  = 0;
+	if (!lines || lines->error)
+		return (-1);
+	if (lines->size < 0)
+		return (ft_getline_view(&lines->reader, line, len));
+	page = sysconf(_SC_PAGESIZE);
+	scan = lines->pos;
+	while (scan < lines->size)
+	{
+		if (!lines->map || scan >= lines->base + (off_t) lines->map_len)
+		{
+			if (lines->map && lines->base == lines->pos - lines->pos % page)
+				lines->window *= 2;
+			if (map_window(lines, lines->pos) == -1)
+				return (-1);
+		}
+		end     = lines->base + lines->map_len;
+		newline = ft_memchr(lines->map + (scan - lines->base), '\n',
+		                    end - scan);
+		scan    = (newline) ? lines->base + (newline - lines->map) + 1 : end;
+		if (newline)
+			break;
+	}
+	if (scan == lines->pos)
+	{
+		unmap_window(lines);
+		return (0);
+	}
+	*line      = lines->map + (lines->pos - lines->base);
+	*len       = scan - lines->pos;
+	lines->pos = scan;
+	return (1);
+}
+
+/**
+ * @brief Releases the mapping or buffer of an iterator.
+ *
+ * @details
+ * The descriptor is left open.
+ *
+ * @param lines The iterator (NULL is ignored).
+ *
+ * @ingroup file_utils
+ */
+void ft_mmap_lines_close(t_mmap_lines* lines)
+{
+	if (!lines)
+		return;
+	unmap_window(lines);
+	ft_linereader_destroy(&lines->reader);
+}
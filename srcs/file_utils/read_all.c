@@ -0,0 +1,136 @@
+/**
+ * @file read_all.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Reading a whole file descriptor into one buffer.
+ *
+ * @details
+ * `ft_read_all` loads everything left on a descriptor into a single
+ * null-terminated buffer, for callers that want a whole configuration or
+ * data file in memory rather than its lines one by one. A regular file
+ * is sized with `fstat`, so it costs one allocation and, in the common
+ * case, two `read` calls: one for the contents and one that confirms the
+ * end of file. Pipes and other descriptors of unknown size grow the
+ * buffer geometrically, so the copies stay linear in the input.
+ *
+ * @ingroup file_utils
+ */
+
+#include "libft.h"
+#include <sys/stat.h>
+
+/**
+ * @brief Returns the size of the first buffer for a descriptor.
+ *
+ * @details
+ * For a regular file, what is left from the current offset plus two
+ * bytes: one for the terminating `\0` and one so the read that finds
+ * the end of file does not need a larger buffer. For anything else,
+ * `READ_ALL_MIN_SIZE`, which is also the least returned: files in
+ * `/proc` and `/sys` report a size of 0 whatever they hold, and would
+ * otherwise start from a two-byte buffer.
+ *
+ * @param fd The file descriptor.
+ *
+ * @return The capacity to allocate.
+ *
+ * @ingroup file_utils
+ */
+static size_t initial_capacity(int fd)
+{
+	struct stat st;
+	off_t       offset;
+
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode))
+		return (READ_ALL_MIN_SIZE);
+	offset = lseek(fd, 0, SEEK_CUR);
+	if (offset < 0 || offset > st.st_size)
+		offset = st.st_size;
+	if (st.st_size - offset + 2 < READ_ALL_MIN_SIZE)
+		return (READ_ALL_MIN_SIZE);
+	return (st.st_size - offset + 2);
+}
+
+/**
+ * @brief Doubles the capacity of the buffer.
+ *
+ * @param data The buffer, replaced on success and left alone on failure.
+ * @param cap Its capacity, updated on success.
+ * @param len Bytes of it in use.
+ *
+ * @return 0 on success, -1 if allocation fails.
+ *
+ * @see ft_realloc
+ * @ingroup file_utils
+ */
+static int grow(char** data, size_t* cap, size_t len)
+{
+	char* new_data;
+
+	new_data = ft_realloc(*data, len, *cap * 2);
+	if (!new_data)
+		return (-1);
+	*data = new_data;
+	*cap *= 2;
+	return (0);
+}
+
+/**
+ * @brief Reads everything left on a file descriptor into one buffer.
+ *
+ * @details
+ * Reads from the current offset until end of file. Reads interrupted
+ * by a signal are retried, and short reads are simply followed by more
+ * reads, so the result is complete whatever the descriptor. A file
+ * that grows while it is read is read to its new end.
+ *
+ * The buffer is null-terminated, but may also hold NUL bytes of its
+ * own: `*len` is the number of bytes read.
+ *
+ * @param fd The file descriptor to read from.
+ * @param len Receives the number of bytes read (may be NULL; 0 on
+ *            failure).
+ *
+ * @return The contents, or NULL if `fd` is negative or a read or an
+ *         allocation fails.
+ *
+ * @note Caller is responsible for freeing the returned buffer.
+ *
+ * @see initial_capacity
+ * @ingroup file_utils
+ */
+char* ft_read_all(int fd, size_t* len)
+{
+	char*   data;
+	size_t  cap;
+	size_t  used;
+	ssize_t bytes_read;
+
+	if (len)
+		*len = 0;
+	if (fd < 0)
+		return (NULL);
+	cap  = initial_capacity(fd);
+	data = malloc(cap);
+	used = 0;
+	while (data)
+	{
+		if (cap - used < 2 && grow(&data, &cap, used) == -1)
+			break;
+		bytes_read = read(fd, data + used, cap - used - 1);
+		if (bytes_read == -1 && errno == EINTR)
+			continue;
+		if (bytes_read <= 0)
+		{
+			if (bytes_read == -1)
+				break;
+			data[used] = '\0';
+			if (len)
+				*len = used;
+			return (data);
+		}
+		used += bytes_read;
+	}
+	free(data);
+	return (NULL);
+}
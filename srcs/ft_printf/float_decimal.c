@@ -0,0 +1,581 @@
+/**
+ * @file float_decimal.c
+ * @brief Correctly rounded decimal digits of a double.
+ *
+ * @details
+ * `float_to_decimal` produces the digits `%e`, `%f` and `%g` print,
+ * rounded half to even from the exact binary value:
+ * - The fast path scales the value by a power of ten with one 192-bit
+ *   multiplication against the Ryu tables of `float_shortest.c`, so that
+ *   the digits to keep form the integer part. The error of the table
+ *   entry is bounded, and the result is used only when the fraction is
+ *   far enough from a rounding boundary for that error not to matter.
+ * - Otherwise the exact expansion is generated with a small big integer:
+ *   the integer part in base 10^9, the fraction by repeated
+ *   multiplication by 10^19, stopping as soon as the digits up to the
+ *   rounding position and a sticky bit are known.
+ *
+ * @author Toonsa
+ * @date 2026/10/19
+ * @ingroup ft_printf
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Base 10^9 chunks of the largest integer part, below 2^1024.
+ */
+#define PF_BIG_CHUNKS 36
+
+/**
+ * @brief 10^19, the largest power of ten below 2^64.
+ */
+#define PF_POW10_19 10000000000000000000ULL
+
+/**
+ * @brief Room for every digit of the exact expansion of a double.
+ *
+ * A leading carry digit, at most 17 integer digits and 1074 fraction
+ * digits when there is a fraction, with one extra 19-digit chunk.
+ */
+#define PF_EXACT_DIGITS 1120
+
+/**
+ * @brief Most significant digits `scaled_decimal` handles.
+ *
+ * One more digit may come out of the scaling, and 18 digits still fit in
+ * 64 bits.
+ */
+#define PF_SCALED_MAX_DIGITS 17
+
+/**
+ * @brief Number of entries of the `pow5_inv_split` table.
+ */
+#define PF_POW5_INV_COUNT 342
+
+/**
+ * @brief Number of entries of the `pow5_split` table.
+ */
+#define PF_POW5_COUNT 326
+
+/**
+ * @brief Returns the IEEE 754 bit pattern of a double.
+ *
+ * @param value The value to inspect.
+ *
+ * @return Its 64 bits: sign, 11 exponent bits, 52 mantissa bits.
+ *
+ * @ingroup ft_printf
+ */
+uint64_t double_to_bits(double value)
+{
+	uint64_t bits;
+
+	ft_memcpy(&bits, &value, sizeof(bits));
+	return (bits);
+}
+
+/**
+ * @brief Writes `count` digits of `value`, zero-filled on the left.
+ * @ingroup ft_printf
+ */
+static void put_chunk(char* out, uint64_t value, int count)
+{
+	while (count-- > 0)
+	{
+		out[count] = '0' + value % 10;
+		value /= 10;
+	}
+}
+
+/**
+ * @brief Writes the decimal digits of `m * 2^e2`, for `e2 >= 0`.
+ *
+ * @details
+ * The value is kept in base 10^9 and multiplied by 2^29 until the whole
+ * power of two is applied, so no step needs a division by a variable.
+ *
+ * @param m The mantissa.
+ * @param e2 The binary exponent, non-negative.
+ * @param out Destination, with room for 330 digits.
+ *
+ * @return The number of digits written.
+ *
+ * @ingroup ft_printf
+ */
+static int big_integer_digits(uint64_t m, int e2, char* out)
+{
+	uint32_t chunks[PF_BIG_CHUNKS];
+	uint64_t cur;
+	char     buf[PF_NUM_BUF_SIZE];
+	char*    start;
+	int      count;
+	int      shift;
+	int      i;
+
+	count = 0;
+	while (count == 0 || m != 0)
+	{
+		chunks[count++] = m % 1000000000;
+		m /= 1000000000;
+	}
+	while (e2 > 0)
+	{
+		shift = (e2 < 29) ? e2 : 29;
+		cur   = 0;
+		i     = 0;
+		while (i < count)
+		{
+			cur       = ((uint64_t) chunks[i] << shift) + cur;
+			chunks[i] = cur % 1000000000;
+			cur /= 1000000000;
+			i++;
+		}
+		if (cur)
+			chunks[count++] = cur;
+		e2 -= shift;
+	}
+	start = render_unsigned(chunks[count - 1], 10, "0123456789",
+	                       buf + PF_NUM_BUF_SIZE);
+	i     = buf + PF_NUM_BUF_SIZE - start;
+	ft_memcpy(out, start, i);
+	while (--count > 0)
+	{
+		put_chunk(out + i, chunks[count - 1], 9);
+		i += 9;
+	}
+	return (i);
+}
+
+/**
+ * @brief Multiplies the fraction by 10^19 and takes out the integer part.
+ *
+ * @details
+ * The bits of the product at or above `frac->bits` are the next 19
+ * decimal digits. Limbs that become zero at the bottom are skipped from
+ * then on.
+ *
+ * @param frac The fraction, updated in place.
+ *
+ * @return The next 19 digits, as an integer below 10^19.
+ *
+ * @ingroup ft_printf
+ */
+static uint64_t next_fraction_chunk(t_pf_frac* frac)
+{
+	__uint128_t cur;
+	uint64_t    carry;
+	int         top_bits;
+	int         i;
+
+	carry = 0;
+	i     = frac->low;
+	while (i < frac->count)
+	{
+		cur            = (__uint128_t) frac->words[i] * PF_POW10_19 + carry;
+		frac->words[i] = (uint64_t) cur;
+		carry          = (uint64_t) (cur >> 64);
+		i++;
+	}
+	top_bits = frac->bits - 64 * (frac->count - 1);
+	if (top_bits < 64)
+	{
+		carry = (carry << (64 - top_bits)) |
+		        (frac->words[frac->count - 1] >> top_bits);
+		frac->words[frac->count - 1] &= (1ULL << top_bits) - 1;
+	}
+	while (frac->low < frac->count && frac->words[frac->low] == 0)
+		frac->low++;
+	return (carry);
+}
+
+/**
+ * @brief Rounds the digit string half to even before index `cut`.
+ *
+ * @details
+ * `digits[0]` is a spare `'0'` that absorbs a carry out of the leading
+ * digit, so `cut` is always at least 1.
+ *
+ * @param digits The digits; updated in place.
+ * @param len Number of known digits.
+ * @param cut Index of the first dropped digit.
+ * @param sticky Non-zero when non-zero digits follow the known ones.
+ *
+ * @return The new number of digits (`cut`, or `len` if nothing was cut).
+ *
+ * @ingroup ft_printf
+ */
+static int round_digits(char* digits, int len, int cut, int sticky)
+{
+	int i;
+	int up;
+
+	if (cut >= len)
+		return (len);
+	i = cut + 1;
+	while (!sticky && i < len)
+		sticky = (digits[i++] != '0');
+	up = (digits[cut] > '5' ||
+	      (digits[cut] == '5' && (sticky || (digits[cut - 1] - '0') % 2)));
+	if (!up)
+		return (cut);
+	i = cut - 1;
+	while (digits[i] == '9')
+		digits[i--] = '0';
+	digits[i]++;
+	return (cut);
+}
+
+/**
+ * @brief Stores rounded digits into `dec`, without surrounding zeros.
+ *
+ * @param digits The digit string; `digits[point]` is the first fraction
+ *               digit.
+ * @param len Number of digits.
+ * @param point Position of the decimal point.
+ * @param dec Destination.
+ *
+ * @ingroup ft_printf
+ */
+static void store_digits(const char* digits, int len, int point,
+                         t_pf_dec* dec)
+{
+	int first;
+
+	first = 0;
+	while (first < len && digits[first] == '0')
+		first++;
+	while (len > first && digits[len - 1] == '0')
+		len--;
+	dec->len = len - first;
+	if (dec->len > PF_DEC_DIGITS)
+		dec->len = PF_DEC_DIGITS;
+	dec->exp = (dec->len) ? point - 1 - first : 0;
+	if (dec->len)
+		ft_memcpy(dec->digits, digits + first, dec->len);
+}
+
+/**
+ * @brief Finds the first non-zero digit at or after `from`.
+ *
+ * @return Its index, or -1 if there is none yet.
+ *
+ * @ingroup ft_printf
+ */
+static int first_significant(const char* digits, int from, int len)
+{
+	while (from < len)
+	{
+		if (digits[from] != '0')
+			return (from);
+		from++;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Writes the digits of the integer part of `m * 2^e2`.
+ *
+ * @details
+ * The integer part is written in full after the spare carry digit. For
+ * a negative `e2`, the fraction bits are left in `frac` for
+ * `next_fraction_chunk`.
+ *
+ * @param m The mantissa.
+ * @param e2 The binary exponent.
+ * @param digits Destination; `digits[0]` is the spare carry digit.
+ * @param frac Receives the fraction (empty when `e2 >= 0`).
+ *
+ * @return The number of digits written, including the spare one.
+ *
+ * @ingroup ft_printf
+ */
+static int integer_part(uint64_t m, int e2, char* digits, t_pf_frac* frac)
+{
+	char  buf[PF_NUM_BUF_SIZE];
+	char* start;
+	int   len;
+
+	digits[0]   = '0';
+	frac->count = 0;
+	frac->low   = 0;
+	if (e2 >= 0)
+		return (1 + big_integer_digits(m, e2, digits + 1));
+	len = 1;
+	if (-e2 < 64 && (m >> -e2) != 0)
+	{
+		start = render_unsigned(m >> -e2, 10, "0123456789",
+		                        buf + PF_NUM_BUF_SIZE);
+		ft_memcpy(digits + 1, start, buf + PF_NUM_BUF_SIZE - start);
+		len += buf + PF_NUM_BUF_SIZE - start;
+	}
+	if (-e2 < 64)
+		m &= (1ULL << -e2) - 1;
+	frac->bits  = -e2;
+	frac->count = (-e2 + 63) / 64;
+	ft_bzero(frac->words, frac->count * sizeof(uint64_t));
+	frac->words[0] = m;
+	while (frac->low < frac->count && frac->words[frac->low] == 0)
+		frac->low++;
+	return (len);
+}
+
+/**
+ * @brief Rounds the exact value of `m * 2^e2` to the requested digits.
+ *
+ * @details
+ * Fraction digits are produced 19 at a time, and only until the rounding
+ * position and one more digit are known; whatever is left of the
+ * fraction becomes the sticky bit.
+ *
+ * @param m The mantissa, non-zero.
+ * @param e2 The binary exponent.
+ * @param precision Digits to keep: significant digits, or fraction
+ *                  digits when `fixed` is set.
+ * @param fixed Selects the `%f` meaning of `precision`.
+ * @param dec Receives the rounded digits.
+ *
+ * @ingroup ft_printf
+ */
+static void exact_decimal(uint64_t m, int e2, int precision, int fixed,
+                          t_pf_dec* dec)
+{
+	char      digits[PF_EXACT_DIGITS];
+	t_pf_frac frac;
+	int       len;
+	int       point;
+	int       first;
+
+	len   = integer_part(m, e2, digits, &frac);
+	point = len;
+	first = first_significant(digits, 1, len);
+	while (frac.low < frac.count &&
+	       ((fixed) ? len <= point + precision
+	                : (first < 0 || len <= first + precision)))
+	{
+		put_chunk(digits + len, next_fraction_chunk(&frac), 19);
+		len += 19;
+		if (first < 0)
+			first = first_significant(digits, len - 19, len);
+	}
+	len = round_digits(digits, len, ((fixed) ? point : first) + precision,
+	                   frac.low < frac.count);
+	store_digits(digits, len, point, dec);
+}
+
+/**
+ * @brief Returns `floor(x * log10(2))` for `x` in [-1650, 1650].
+ * @ingroup ft_printf
+ */
+static int floor_log10_pow2(int x)
+{
+	if (x >= 0)
+		return (log10_pow2(x));
+	return (-log10_pow2(-x) - 1);
+}
+
+/**
+ * @brief Returns 64 bits of the 192-bit number `w`, from bit `shift` up.
+ * @ingroup ft_printf
+ */
+static uint64_t bits_at(const uint64_t* w, int shift)
+{
+	uint64_t bits;
+	int      word;
+
+	word = shift / 64;
+	if (word >= 3)
+		return (0);
+	bits = w[word] >> (shift % 64);
+	if (shift % 64 && word < 2)
+		bits |= w[word + 1] << (64 - shift % 64);
+	return (bits);
+}
+
+/**
+ * @brief Tells whether any of the lowest `count` bits of `w` is set.
+ * @ingroup ft_printf
+ */
+static int bits_below(const uint64_t* w, int count)
+{
+	int word;
+
+	word = 0;
+	while (count >= 64)
+	{
+		if (w[word++])
+			return (1);
+		count -= 64;
+	}
+	return (count > 0 && (w[word] & ((1ULL << count) - 1)) != 0);
+}
+
+/**
+ * @brief Multiplies `m * 2^e2` by `10^-q` with a Ryu table entry.
+ *
+ * @details
+ * Stores a 192-bit product `w` such that `w / 2^j` is the scaled value.
+ * For `q > 0` the entry approximates `2^k / 5^q` from above; for
+ * `q <= 0` it holds the top bits of `5^-q`, exactly up to `5^53`.
+ * Either way `w / 2^j` is off by less than `2^(53 - j)`.
+ *
+ * @param m The mantissa, below 2^53.
+ * @param e2 The binary exponent.
+ * @param q The power of ten to divide by.
+ * @param w Receives the product, least significant word first.
+ * @param exact Set to 1 if the product is exact.
+ *
+ * @return The shift `j`, or -1 if `q` is outside the tables.
+ *
+ * @ingroup ft_printf
+ */
+static int scale_by_pow10(uint64_t m, int e2, int q, uint64_t* w, int* exact)
+{
+	const uint64_t* entry;
+	__uint128_t     low;
+	__uint128_t     high;
+	__uint128_t     mid;
+	int             shift;
+
+	if (q >= PF_POW5_INV_COUNT || -q >= PF_POW5_COUNT)
+		return (-1);
+	if (q > 0)
+	{
+		entry  = pow5_inv_split(q);
+		shift  = pow5_bits(q) + 124 + q - e2;
+		*exact = 0;
+	}
+	else
+	{
+		entry  = pow5_split(-q);
+		shift  = 125 - pow5_bits(-q) + q - e2;
+		*exact = (pow5_bits(-q) <= 125);
+	}
+	low  = (__uint128_t) m * entry[0];
+	high = (__uint128_t) m * entry[1];
+	mid  = (low >> 64) + (uint64_t) high;
+	w[0] = (uint64_t) low;
+	w[1] = (uint64_t) mid;
+	w[2] = (uint64_t) (high >> 64) + (uint64_t) (mid >> 64);
+	return (shift);
+}
+
+/**
+ * @brief Tells whether an approximate fraction is too close to call.
+ *
+ * @details
+ * Rounding depends on where the fraction lies relative to 0, 1/2 and 1.
+ * An inexact product decides it only when the fraction is further from
+ * each of them than the error bound `2^(53 - shift)`.
+ *
+ * @param fraction The fraction, in units of 2^-64.
+ * @param shift The shift `j` returned by `scale_by_pow10`.
+ *
+ * @return 1 if the exact path must decide, 0 otherwise.
+ *
+ * @ingroup ft_printf
+ */
+static int fraction_is_ambiguous(uint64_t fraction, int shift)
+{
+	uint64_t margin;
+
+	margin = (shift > 117) ? 2 : (1ULL << (117 - shift)) + 1;
+	return (fraction < margin || fraction > UINT64_MAX - margin ||
+	        fraction + margin - (1ULL << 63) < 2 * margin);
+}
+
+/**
+ * @brief Rounds `m * 2^e2` through a single 192-bit multiplication.
+ *
+ * @details
+ * The value is scaled by a power of ten so that its integer part holds
+ * the digits to keep (and possibly one more), and the fraction below
+ * decides the rounding. This covers `%f` whenever `value * 10^precision`
+ * fits in 64 bits, and `%e` / `%g` up to 17 significant digits.
+ *
+ * @param m The mantissa, non-zero.
+ * @param e2 The binary exponent.
+ * @param precision Digits to keep, as for `float_to_decimal`.
+ * @param fixed Selects the `%f` meaning of `precision`.
+ * @param dec Receives the rounded digits.
+ *
+ * @return 1 on success, 0 if `exact_decimal` must be used instead.
+ *
+ * @ingroup ft_printf
+ */
+static int scaled_decimal(uint64_t m, int e2, int precision, int fixed,
+                          t_pf_dec* dec)
+{
+	uint64_t    w[3];
+	char        buf[PF_NUM_BUF_SIZE];
+	char        digits[PF_NUM_BUF_SIZE + 2];
+	char*       start;
+	__uint128_t next;
+	int         exact;
+	int         shift;
+	int         count;
+	int         len;
+	int         q;
+
+	if (!fixed && precision > PF_SCALED_MAX_DIGITS)
+		return (0);
+	q     = (fixed) ? -precision : floor_log10_pow2(e2 + 52) - precision + 1;
+	shift = scale_by_pow10(m, e2, q, w, &exact);
+	if (shift < 64 || shift >= 192 || bits_at(w, shift + 64) != 0 ||
+	    (!exact && fraction_is_ambiguous(bits_at(w, shift - 64), shift)))
+		return (0);
+	start = render_unsigned(bits_at(w, shift), 10, "0123456789",
+	                        buf + PF_NUM_BUF_SIZE);
+	count = buf + PF_NUM_BUF_SIZE - start;
+	if (!fixed && (*start == '0' || count < precision || count > precision + 1))
+		return (0);
+	digits[0] = '0';
+	ft_memcpy(digits + 1, start, count);
+	next              = (__uint128_t) bits_at(w, shift - 64) * 10;
+	digits[count + 1] = '0' + (int) (next >> 64);
+	len               = round_digits(digits, count + 2,
+	                                 (fixed) ? count + 1 : precision + 1,
+	                                 (uint64_t) next != 0 ||
+	                                     bits_below(w, shift - 64));
+	store_digits(digits, len, 1 + count + q, dec);
+	return (1);
+}
+
+/**
+ * @brief Computes the correctly rounded digits of a finite double.
+ *
+ * @details
+ * The sign is ignored. With `fixed` unset, `precision` (at least 1) is
+ * the number of significant digits, as `%e` and `%g` need; with `fixed`
+ * set, it is the number of digits after the decimal point, as `%f`
+ * needs. `dec` holds the rounded digits without trailing zeros, and is
+ * empty when the value is zero or rounds to zero.
+ *
+ * @param value The finite value to convert.
+ * @param precision Number of digits to keep.
+ * @param fixed Selects the `%f` meaning of `precision`.
+ * @param dec Receives the digits and the decimal exponent.
+ *
+ * @ingroup ft_printf
+ */
+void float_to_decimal(double value, int precision, int fixed, t_pf_dec* dec)
+{
+	uint64_t bits;
+	uint64_t mantissa;
+	int      exponent;
+
+	bits     = double_to_bits(value);
+	mantissa = bits & ((1ULL << 52) - 1);
+	exponent = (int) ((bits >> 52) & 0x7FF);
+	dec->len = 0;
+	dec->exp = 0;
+	if (mantissa == 0 && exponent == 0)
+		return;
+	if (exponent != 0)
+		mantissa |= 1ULL << 52;
+	exponent = ((exponent) ? exponent : 1) - 1075;
+	if (precision > PF_EXACT_DIGITS)
+		precision = PF_EXACT_DIGITS;
+	if (!scaled_decimal(mantissa, exponent, precision, fixed, dec))
+		exact_decimal(mantissa, exponent, precision, fixed, dec);
+}
@@ -0,0 +1,451 @@
+/**
+ * @file format_and_print_float.c
+ * @brief Handles floating-point specifiers for ft_printf.
+ *
+ * @details
+ * This file implements the floating-point format specifiers of
+ * `ft_printf`:
+ * - `%f` / `%F` (fixed notation)
+ * - `%e` / `%E` (scientific notation)
+ * - `%g` / `%G` (the shorter of both, without trailing zeros)
+ * - `%a` / `%A` (hexadecimal significand, exact)
+ *
+ * Decimal digits come from `float_to_decimal`, correctly rounded from the
+ * exact binary value. The layout writes them straight into the output
+ * sink, with zero runs added by `print_padding`, so even `%.500f` needs
+ * no allocation. Infinities and NaNs print as `inf` and `nan` (`INF`,
+ * `NAN` for the uppercase specifiers), padded with spaces.
+ *
+ * @author Toonsa
+ * @date 2026/10/19
+ * @ingroup ft_printf
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Returns the sign prefix of a floating-point conversion.
+ *
+ * @param fmt Format descriptor (flags).
+ * @param bits IEEE 754 bits of the value; the sign bit is used.
+ *
+ * @return `"-"`, `"+"`, `" "` or `""`.
+ *
+ * @ingroup ft_printf
+ */
+static const char* float_sign(t_fmt* fmt, uint64_t bits)
+{
+	if (bits >> 63)
+		return ("-");
+	if (fmt->flags & FLAG_PLUS)
+		return ("+");
+	if (fmt->flags & FLAG_SPACE)
+		return (" ");
+	return ("");
+}
+
+/**
+ * @brief Prints everything a field needs before its body.
+ *
+ * @details
+ * Prints the left padding, the prefix and, for finite values with the
+ * `0` flag, the zeros that fill the field after the prefix.
+ *
+ * @param fmt Format descriptor (flags, width).
+ * @param prefix Sign, and `0x` for `%a`.
+ * @param body_len Length of the body printed after the prefix.
+ * @param zero_pad Non-zero if the `0` flag applies.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @return The padding to print after the body.
+ *
+ * @ingroup ft_printf
+ */
+static int print_float_lead(t_fmt* fmt, const char* prefix, int body_len,
+                            int zero_pad, t_pf* pf)
+{
+	int prefix_len;
+	int padding;
+	int zeros;
+
+	prefix_len = ft_strlen(prefix);
+	padding    = handle_width(fmt, prefix_len + body_len);
+	zeros      = 0;
+	if (zero_pad && (fmt->flags & FLAG_ZERO) && !(fmt->flags & FLAG_MINUS))
+	{
+		zeros   = padding;
+		padding = 0;
+	}
+	if (!(fmt->flags & FLAG_MINUS))
+		print_padding(padding, ' ', pf);
+	write_safely_len((char*) prefix, prefix_len, pf);
+	print_padding(zeros, '0', pf);
+	return ((fmt->flags & FLAG_MINUS) ? padding : 0);
+}
+
+/**
+ * @brief Prints `inf` or `nan` if the value is not finite.
+ *
+ * @param fmt Format descriptor (flags, width, specifier).
+ * @param bits IEEE 754 bits of the value.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @return 1 if the value was printed, 0 if it is finite.
+ *
+ * @ingroup ft_printf
+ */
+static int print_non_finite(t_fmt* fmt, uint64_t bits, t_pf* pf)
+{
+	const char* text;
+	int         upper;
+	int         padding;
+
+	if (((bits >> 52) & 0x7FF) != 0x7FF)
+		return (0);
+	upper = ft_isupper(fmt->specifier);
+	if (bits & ((1ULL << 52) - 1))
+		text = (upper) ? "NAN" : "nan";
+	else
+		text = (upper) ? "INF" : "inf";
+	padding = print_float_lead(fmt, float_sign(fmt, bits), 3, 0, pf);
+	write_safely_len((char*) text, 3, pf);
+	print_padding(padding, ' ', pf);
+	return (1);
+}
+
+/**
+ * @brief Prints digits in fixed notation.
+ *
+ * @details
+ * Digits of `dec` that fall outside its stored range are zeros.
+ *
+ * @param dec The rounded digits.
+ * @param precision Number of digits after the decimal point.
+ * @param point Non-zero to print the decimal point.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @ingroup ft_printf
+ */
+static void print_fixed(const t_pf_dec* dec, int precision, int point,
+                        t_pf* pf)
+{
+	int count;
+	int lead;
+	int start;
+
+	if (dec->len == 0 || dec->exp < 0)
+		write_char_safely('0', pf);
+	else
+	{
+		count = (dec->len < dec->exp + 1) ? dec->len : dec->exp + 1;
+		write_safely_len((char*) dec->digits, count, pf);
+		print_padding(dec->exp + 1 - count, '0', pf);
+	}
+	if (point)
+		write_char_safely('.', pf);
+	lead = (dec->len == 0 || -dec->exp - 1 > precision) ? precision
+	                                                     : -dec->exp - 1;
+	if (lead < 0)
+		lead = 0;
+	print_padding(lead, '0', pf);
+	start = dec->exp + 1 + lead;
+	count = (dec->len > start) ? dec->len - start : 0;
+	if (count > precision - lead)
+		count = precision - lead;
+	write_safely_len((char*) dec->digits + start, count, pf);
+	print_padding(precision - lead - count, '0', pf);
+}
+
+/**
+ * @brief Prints digits in scientific notation, exponent included.
+ *
+ * @param dec The rounded digits (empty for zero).
+ * @param precision Number of digits after the decimal point.
+ * @param point Non-zero to print the decimal point.
+ * @param upper Non-zero for an `E` exponent marker.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @ingroup ft_printf
+ */
+static void print_scientific(const t_pf_dec* dec, int precision, int point,
+                             int upper, t_pf* pf)
+{
+	char buf[5];
+	int  count;
+	int  exp;
+	int  len;
+
+	write_char_safely((dec->len) ? dec->digits[0] : '0', pf);
+	if (point)
+		write_char_safely('.', pf);
+	count = (dec->len > 1) ? dec->len - 1 : 0;
+	if (count > precision)
+		count = precision;
+	write_safely_len((char*) dec->digits + 1, count, pf);
+	print_padding(precision - count, '0', pf);
+	exp          = (dec->exp < 0) ? -dec->exp : dec->exp;
+	len          = (exp >= 100) ? 5 : 4;
+	buf[0]       = (upper) ? 'E' : 'e';
+	buf[1]       = (dec->exp < 0) ? '-' : '+';
+	buf[2]       = '0' + exp / 100;
+	buf[len - 2] = '0' + exp / 10 % 10;
+	buf[len - 1] = '0' + exp % 10;
+	write_safely_len(buf, len, pf);
+}
+
+/**
+ * @brief Lays out a decimal conversion in its field.
+ *
+ * @param fmt Format descriptor (flags, width, specifier).
+ * @param bits IEEE 754 bits of the value, for the sign.
+ * @param dec The rounded digits.
+ * @param precision Number of digits after the decimal point.
+ * @param scientific Non-zero for `%e` notation, zero for `%f`.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @ingroup ft_printf
+ */
+static void print_float_decimal(t_fmt* fmt, uint64_t bits,
+                                const t_pf_dec* dec, int precision,
+                                int scientific, t_pf* pf)
+{
+	int point;
+	int len;
+	int padding;
+	int exp;
+
+	point = (precision > 0 || (fmt->flags & FLAG_HASH));
+	exp   = (dec->exp < 0) ? -dec->exp : dec->exp;
+	if (scientific)
+		len = 1 + point + precision + ((exp >= 100) ? 5 : 4);
+	else
+		len = ((dec->len && dec->exp > 0) ? dec->exp + 1 : 1) + point +
+		      precision;
+	padding = print_float_lead(fmt, float_sign(fmt, bits), len, 1, pf);
+	if (scientific)
+		print_scientific(dec, precision, point, ft_isupper(fmt->specifier),
+		                 pf);
+	else
+		print_fixed(dec, precision, point, pf);
+	print_padding(padding, ' ', pf);
+}
+
+/**
+ * @brief Handles `%f` and `%F` format specifiers for ft_printf.
+ *
+ * @details
+ * Prints `[-]ddd.ddd` with `precision` digits after the point (6 by
+ * default). The point is omitted for a zero precision unless the `#`
+ * flag is set.
+ *
+ * @param fmt Format descriptor (flags, width, precision).
+ * @param args Pointer to `va_list` with the `double` argument.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @see float_to_decimal
+ * @ingroup ft_printf
+ */
+void format_and_print_f(t_fmt* fmt, va_list* args, t_pf* pf)
+{
+	double   value;
+	uint64_t bits;
+	int      precision;
+	t_pf_dec dec;
+
+	value = va_arg(*args, double);
+	bits  = double_to_bits(value);
+	if (print_non_finite(fmt, bits, pf))
+		return;
+	precision = (fmt->precision < 0) ? 6 : fmt->precision;
+	float_to_decimal(value, precision, 1, &dec);
+	print_float_decimal(fmt, bits, &dec, precision, 0, pf);
+}
+
+/**
+ * @brief Handles `%e` and `%E` format specifiers for ft_printf.
+ *
+ * @details
+ * Prints `[-]d.ddde±dd` with `precision` digits after the point (6 by
+ * default) and an exponent of at least two digits.
+ *
+ * @param fmt Format descriptor (flags, width, precision, specifier).
+ * @param args Pointer to `va_list` with the `double` argument.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @see float_to_decimal
+ * @ingroup ft_printf
+ */
+void format_and_print_e(t_fmt* fmt, va_list* args, t_pf* pf)
+{
+	double   value;
+	uint64_t bits;
+	int      precision;
+	t_pf_dec dec;
+
+	value = va_arg(*args, double);
+	bits  = double_to_bits(value);
+	if (print_non_finite(fmt, bits, pf))
+		return;
+	precision = (fmt->precision < 0) ? 6 : fmt->precision;
+	float_to_decimal(value, precision + 1, 0, &dec);
+	print_float_decimal(fmt, bits, &dec, precision, 1, pf);
+}
+
+/**
+ * @brief Handles `%g` and `%G` format specifiers for ft_printf.
+ *
+ * @details
+ * The value is rounded to P significant digits (the precision, 6 by
+ * default, at least 1). With X its decimal exponent, it prints like `%f`
+ * when `P > X >= -4` and like `%e` otherwise. Trailing zeros, and a
+ * trailing decimal point, are removed unless the `#` flag is set.
+ *
+ * @param fmt Format descriptor (flags, width, precision, specifier).
+ * @param args Pointer to `va_list` with the `double` argument.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @see float_to_decimal
+ * @ingroup ft_printf
+ */
+void format_and_print_g(t_fmt* fmt, va_list* args, t_pf* pf)
+{
+	double   value;
+	uint64_t bits;
+	int      significant;
+	int      precision;
+	int      fixed;
+	t_pf_dec dec;
+
+	value = va_arg(*args, double);
+	bits  = double_to_bits(value);
+	if (print_non_finite(fmt, bits, pf))
+		return;
+	significant = (fmt->precision < 0) ? 6 : fmt->precision;
+	if (significant == 0)
+		significant = 1;
+	float_to_decimal(value, significant, 0, &dec);
+	fixed     = (significant > dec.exp && dec.exp >= -4);
+	precision = (fmt->flags & FLAG_HASH) ? significant - 1 : dec.len - 1;
+	if (fixed)
+		precision -= dec.exp;
+	if (precision < 0)
+		precision = 0;
+	print_float_decimal(fmt, bits, &dec, precision, !fixed, pf);
+}
+
+/**
+ * @brief Rounds the 52 fraction bits of `%a` to `precision` hex digits.
+ *
+ * @details
+ * Rounds half to even; a carry out of the fraction increments the
+ * leading digit, which then prints as `2`.
+ *
+ * @param fraction The fraction bits, replaced by the kept digits.
+ * @param lead The leading digit, 0 or 1.
+ * @param precision Number of hex digits to keep, below 13.
+ *
+ * @return The leading digit after rounding.
+ *
+ * @ingroup ft_printf
+ */
+static int round_hex_fraction(uint64_t* fraction, int lead, int precision)
+{
+	int      shift;
+	uint64_t rest;
+	uint64_t half;
+	uint64_t last;
+
+	shift = 4 * (13 - precision);
+	rest  = *fraction & ((1ULL << shift) - 1);
+	half  = 1ULL << (shift - 1);
+	*fraction >>= shift;
+	last = (precision) ? *fraction : (uint64_t) lead;
+	if (rest > half || (rest == half && (last & 1)))
+		(*fraction)++;
+	if (*fraction >> (4 * precision))
+	{
+		*fraction &= (1ULL << (4 * precision)) - 1;
+		lead++;
+	}
+	return (lead);
+}
+
+/**
+ * @brief Handles `%a` and `%A` format specifiers for ft_printf.
+ *
+ * @details
+ * Prints `[-]0xh.hhhp±d`: the leading digit is 1 for normal values and
+ * 0 for subnormals (which use the exponent -1022). Without a precision,
+ * the 13 fraction digits are printed without trailing zeros, which is
+ * exact; with one, they are rounded half to even or extended with zeros.
+ *
+ * @param fmt Format descriptor (flags, width, precision, specifier).
+ * @param args Pointer to `va_list` with the `double` argument.
+ * @param pf State struct tracking write progress and error flags.
+ *
+ * @ingroup ft_printf
+ */
+void format_and_print_a(t_fmt* fmt, va_list* args, t_pf* pf)
+{
+	uint64_t    bits;
+	uint64_t    fraction;
+	const char* hex;
+	int         lead;
+	int         exp;
+	int         count;
+	char        prefix[4];
+	char        body[PF_NUM_BUF_SIZE];
+	char        exp_buf[PF_NUM_BUF_SIZE];
+	char*       exp_str;
+	int         len;
+	int         zeros;
+	int         padding;
+	int         i;
+
+	bits = double_to_bits(va_arg(*args, double));
+	if (print_non_finite(fmt, bits, pf))
+		return;
+	fraction = bits & ((1ULL << 52) - 1);
+	exp      = (int) ((bits >> 52) & 0x7FF);
+	lead     = (exp != 0);
+	exp      = (exp) ? exp - 1023 : ((fraction) ? -1022 : 0);
+	count    = 13;
+	if (fmt->precision >= 0 && fmt->precision < 13)
+	{
+		lead  = round_hex_fraction(&fraction, lead, fmt->precision);
+		count = fmt->precision;
+	}
+	while (fmt->precision < 0 && count > 0 && (fraction & 0xF) == 0)
+	{
+		fraction >>= 4;
+		count--;
+	}
+	hex = (fmt->specifier == 'A') ? "0123456789ABCDEF" : "0123456789abcdef";
+	len = 1 + (count > 0 || (fmt->flags & FLAG_HASH));
+	i   = len + count;
+	while (i-- > len)
+	{
+		body[i] = hex[fraction & 0xF];
+		fraction >>= 4;
+	}
+	body[0] = '0' + lead;
+	body[1] = '.';
+	len += count;
+	exp_str = render_unsigned((exp < 0) ? -exp : exp, 10, "0123456789",
+	                          exp_buf + PF_NUM_BUF_SIZE);
+	*--exp_str = (exp < 0) ? '-' : '+';
+	*--exp_str = (fmt->specifier == 'A') ? 'P' : 'p';
+	prefix[0]  = *float_sign(fmt, bits);
+	prefix[1]  = '0';
+	prefix[2]  = (fmt->specifier == 'A') ? 'X' : 'x';
+	prefix[3]  = '\0';
+	zeros      = (fmt->precision > count) ? fmt->precision - count : 0;
+	padding    = print_float_lead(fmt, prefix + (prefix[0] == '\0'),
+	                              len + zeros +
+	                                  (exp_buf + PF_NUM_BUF_SIZE - exp_str),
+	                              1, pf);
+	write_safely_len(body, len, pf);
+	print_padding(zeros, '0', pf);
+	write_safely_len(exp_str, exp_buf + PF_NUM_BUF_SIZE - exp_str, pf);
+	print_padding(padding, ' ', pf);
+}
@@ -8,9 +8,10 @@
  * - `%u` (unsigned integers)
  * - `%x` / `%X` (hexadecimal values)
  *
- * Each function retrieves the relevant argument from the `va_list`, converts it
- * to a string, applies formatting (precision, padding, width), and delegates
- * final output to `print_formatted_number`.
+ * Each function retrieves the relevant argument from the `va_list` with the
+ * type its length modifier selects (`hh`, `h`, `l`, `ll`, `j`, `z`, `t`),
+ * renders its digits into a stack buffer with `render_unsigned`, picks the
+ * sign or prefix, and delegates the layout to `print_formatted_number`.
  *
  * @author Toonsa
  * @date 2024/10/29
@@ -19,108 +20,194 @@
 
 #include "libft.h"
 
+/**
+ * @brief Reads a signed integer argument of the conversion's length.
+ *
+ * @details
+ * `hh` and `h` arguments are promoted to `int` by the call, then
+ * narrowed back to `signed char` or `short`, as `printf` does. Also
+ * used by the binary logger to record arguments.
+ *
+ * @param fmt Format descriptor (length modifier).
+ * @param args Pointer to `va_list` with the argument.
+ *
+ * @return The argument, widened to 64 bits.
+ *
+ * @ingroup ft_printf
+ */
+int64_t fetch_signed_arg(t_fmt* fmt, va_list* args)
+{
+	if (fmt->length == PF_LEN_HH)
+		return ((signed char) va_arg(*args, int));
+	if (fmt->length == PF_LEN_H)
+		return ((short) va_arg(*args, int));
+	if (fmt->length == PF_LEN_L)
+		return (va_arg(*args, long));
+	if (fmt->length == PF_LEN_LL)
+		return (va_arg(*args, long long));
+	if (fmt->length == PF_LEN_J)
+		return (va_arg(*args, intmax_t));
+	if (fmt->length == PF_LEN_Z)
+		return (va_arg(*args, ssize_t));
+	if (fmt->length == PF_LEN_T)
+		return (va_arg(*args, ptrdiff_t));
+	return (va_arg(*args, int));
+}
+
+/**
+ * @brief Reads an unsigned integer argument of the conversion's length.
+ *
+ * @param fmt Format descriptor (length modifier).
+ * @param args Pointer to `va_list` with the argument.
+ *
+ * @return The argument, widened to 64 bits.
+ *
+ * @see fetch_signed_arg
+ * @ingroup ft_printf
+ */
+uint64_t fetch_unsigned_arg(t_fmt* fmt, va_list* args)
+{
+	if (fmt->length == PF_LEN_HH)
+		return ((unsigned char) va_arg(*args, unsigned int));
+	if (fmt->length == PF_LEN_H)
+		return ((unsigned short) va_arg(*args, unsigned int));
+	if (fmt->length == PF_LEN_L)
+		return (va_arg(*args, unsigned long));
+	if (fmt->length == PF_LEN_LL)
+		return (va_arg(*args, unsigned long long));
+	if (fmt->length == PF_LEN_J)
+		return (va_arg(*args, uintmax_t));
+	if (fmt->length == PF_LEN_Z)
+		return (va_arg(*args, size_t));
+	if (fmt->length == PF_LEN_T)
+		return ((uint64_t) va_arg(*args, ptrdiff_t));
+	return (va_arg(*args, unsigned int));
+}
+
+/**
+ * @brief Renders the digits of a conversion, honoring a zero precision.
+ *
+ * @details
+ * With a precision of 0, the value 0 prints no digit at all.
+ *
+ * @param fmt Format descriptor (precision).
+ * @param value The magnitude to render.
+ * @param base The numeric base.
+ * @param digits The digit characters.
+ * @param buf Stack buffer of `PF_NUM_BUF_SIZE` bytes.
+ * @param len Receives the number of digits.
+ *
+ * @return A pointer to the first digit inside `buf`.
+ *
+ * @see render_unsigned
+ * @ingroup ft_printf
+ */
+static char* render_digits(t_fmt* fmt, uint64_t value, unsigned int base,
+                           const char* digits, char* buf, int* len)
+{
+	char* start;
+
+	if (value == 0 && fmt->precision == 0)
+	{
+		*len = 0;
+		return (buf + PF_NUM_BUF_SIZE);
+	}
+	start = render_unsigned(value, base, digits, buf + PF_NUM_BUF_SIZE);
+	*len  = buf + PF_NUM_BUF_SIZE - start;
+	return (start);
+}
+
 /**
  * @brief Handles `%d` and `%i` format specifiers for ft_printf.
  *
  * @details
- * Converts an integer value to string using `ft_itoa`, applies formatting
- * using `handle_precision_int`, and writes the result using
- * `print_formatted_number`. If a memory allocation fails, the `malloc_error`
- * flag is set in the state struct.
+ * The magnitude is computed in unsigned arithmetic, so `INT64_MIN` needs
+ * no special case. The sign comes from the value or from the `+` and space
+ * flags.
  *
  * @param fmt Format descriptor (flags, width, precision).
  * @param args Pointer to `va_list` with the argument.
  * @param pf State struct tracking write progress and error flags.
  *
- * @see ft_itoa
- * @see handle_precision_int
  * @see print_formatted_number
  * @ingroup ft_printf
  */
 void format_and_print_id(t_fmt* fmt, va_list* args, t_pf* pf)
 {
-	int   num;
-	char* str;
-	int   len;
+	int64_t     num;
+	uint64_t    magnitude;
+	const char* prefix;
+	char        buf[PF_NUM_BUF_SIZE];
+	char*       digits;
+	int         len;
 
-	num = va_arg(*args, int);
-	str = ft_itoa(num);
-	if (!str)
-	{
-		pf->malloc_error = 1;
-		return;
-	}
-	len = ft_strlen(str);
-	str = handle_precision_int(fmt, str, &len, pf);
-	if (!str)
-		return;
-	print_formatted_number(fmt, str, len, pf);
+	num       = fetch_signed_arg(fmt, args);
+	magnitude = (num < 0) ? -(uint64_t) num : (uint64_t) num;
+	if (num < 0)
+		prefix = "-";
+	else if (fmt->flags & FLAG_PLUS)
+		prefix = "+";
+	else if (fmt->flags & FLAG_SPACE)
+		prefix = " ";
+	else
+		prefix = "";
+	digits = render_digits(fmt, magnitude, 10, "0123456789", buf, &len);
+	print_formatted_number(fmt, prefix, digits, len, pf);
 }
 
 /**
  * @brief Handles `%u` format specifier for ft_printf.
  *
- * @details
- * Converts an unsigned integer to string using `ft_utoa`, applies precision,
- * and writes the formatted result using `print_formatted_number`.
- *
  * @param fmt Format descriptor (flags, width, precision).
  * @param args Pointer to `va_list` with the argument.
  * @param pf State struct tracking write progress and error flags.
  *
- * @see ft_utoa
- * @see handle_precision_int
  * @see print_formatted_number
  * @ingroup ft_printf
  */
 void format_and_print_u(t_fmt* fmt, va_list* args, t_pf* pf)
 {
-	unsigned int num;
-	char*        str;
-	int          len;
+	uint64_t num;
+	char     buf[PF_NUM_BUF_SIZE];
+	char*    digits;
+	int      len;
 
-	num = va_arg(*args, unsigned int);
-	str = ft_utoa(num);
-	if (!str)
-		return;
-	len = ft_strlen(str);
-	str = handle_precision_int(fmt, str, &len, pf);
-	if (!str)
-		return;
-	print_formatted_number(fmt, str, len, pf);
+	num    = fetch_unsigned_arg(fmt, args);
+	digits = render_digits(fmt, num, 10, "0123456789", buf, &len);
+	print_formatted_number(fmt, "", digits, len, pf);
 }
 
 /**
  * @brief Handles `%x` and `%X` format specifiers for ft_printf.
  *
  * @details
- * Converts an unsigned integer to hexadecimal using `ft_itoa_base`, applies
- * precision, and prints the formatted result. If `upper` is non-zero, the
- * hexadecimal letters are uppercase (for `%X`).
+ * For `%X` the hexadecimal letters are uppercase. With the `#` flag, a
+ * non-zero value gets the `0x` / `0X` prefix, placed before any zero
+ * padding.
  *
- * @param fmt Format descriptor (flags, width, precision).
+ * @param fmt Format descriptor (flags, width, precision, specifier).
  * @param args Pointer to `va_list` with the argument.
- * @param upper If non-zero, use uppercase letters in output.
  * @param pf State struct tracking write progress and error flags.
  *
- * @see ft_itoa_base
- * @see handle_precision_int
  * @see print_formatted_number
  * @ingroup ft_printf
  */
-void format_and_print_x(t_fmt* fmt, va_list* args, int upper, t_pf* pf)
+void format_and_print_x(t_fmt* fmt, va_list* args, t_pf* pf)
 {
-	unsigned int num;
-	char*        str;
-	int          len;
+	uint64_t    num;
+	int         upper;
+	const char* prefix;
+	char        buf[PF_NUM_BUF_SIZE];
+	char*       digits;
+	int         len;
 
-	num = va_arg(*args, unsigned int);
-	str = ft_itoa_base(num, 16, upper);
-	if (!str)
-		return;
-	len = ft_strlen(str);
-	str = handle_precision_int(fmt, str, &len, pf);
-	if (!str)
-		return;
-	print_formatted_number(fmt, str, len, pf);
+	num    = fetch_unsigned_arg(fmt, args);
+	upper  = (fmt->specifier == 'X');
+	prefix = "";
+	if ((fmt->flags & FLAG_HASH) && num != 0)
+		prefix = (upper) ? "0X" : "0x";
+	digits = render_digits(fmt, num, 16,
+	                       (upper) ? "0123456789ABCDEF" : "0123456789abcdef",
+	                       buf, &len);
+	print_formatted_number(fmt, prefix, digits, len, pf);
 }
@@ -0,0 +1,70 @@
+/**
+ * @file format_and_print_point.c
+ * @brief Conversion handlers for the `ft_math.h` point types.
+ *
+ * @details
+ * These handlers are not bound to any specifier by default; an
+ * application picks its letters with `ft_printf_register`:
+ * - `format_and_print_point` prints a `t_point` as `(x, y)`
+ * - `format_and_print_dpoint` prints a `t_dpoint` as `(x, y)`, with `%g`
+ *   components, or `%f` ones when a precision is given
+ *
+ * Both take the point by value and honor the field width and the `-`
+ * flag.
+ *
+ * @author Toonsa
+ * @date 2026/10/19
+ * @ingroup ft_printf
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Formats and prints a `t_point` argument as `(x, y)`.
+ *
+ * @param fmt Format descriptor (flags, width).
+ * @param args Argument list holding a `t_point`.
+ * @param pf Print context structure.
+ *
+ * @see ft_printf_register
+ * @see ft_printf_field
+ * @ingroup ft_printf
+ */
+void format_and_print_point(t_fmt* fmt, va_list* args, t_pf* pf)
+{
+	t_point point;
+
+	point = va_arg(*args, t_point);
+	ft_printf_field(fmt, pf, "(%d, %d)", point.x, point.y);
+}
+
+/**
+ * @brief Formats and prints a `t_dpoint` argument as `(x, y)`.
+ *
+ * @details
+ * Without a precision the components print like `%g`; with one, like
+ * `%.<precision>f` (e.g. `%.2P` gives `(1.00, -0.50)`).
+ *
+ * @param fmt Format descriptor (flags, width, precision).
+ * @param args Argument list holding a `t_dpoint`.
+ * @param pf Print context structure.
+ *
+ * @see ft_printf_register
+ * @see ft_printf_field
+ * @ingroup ft_printf
+ */
+void format_and_print_dpoint(t_fmt* fmt, va_list* args, t_pf* pf)
+{
+	t_dpoint point;
+	char     format[32];
+
+	point = va_arg(*args, t_dpoint);
+	if (fmt->precision < 0)
+	{
+		ft_printf_field(fmt, pf, "(%g, %g)", point.x, point.y);
+		return;
+	}
+	ft_snprintf(format, sizeof(format), "(%%.%df, %%.%df)", fmt->precision,
+	            fmt->precision);
+	ft_printf_field(fmt, pf, format, point.x, point.y);
+}
@@ -28,6 +28,7 @@
  * `FLAG_MINUS` flag.
  *
  * @param fmt Format descriptor (width and flags).
+ * @param args Unused; present to match the `t_pf_handler` signature.
  * @param pf Print context for error tracking and byte count.
  *
  * @see handle_width
@@ -35,11 +36,12 @@
  * @see write_char_safely
  * @ingroup ft_printf
  */
-void format_and_print_percent(t_fmt* fmt, t_pf* pf)
+void format_and_print_percent(t_fmt* fmt, va_list* args, t_pf* pf)
 {
 	int  padding;
 	char pad_char;
 
+	(void) args;
 	pad_char = (fmt->flags & FLAG_ZERO) ? '0' : ' ';
 	padding  = handle_width(fmt, 1);
 	if (!(fmt->flags & FLAG_MINUS))
@@ -48,7 +50,7 @@ void format_and_print_percent(t_fmt* fmt, t_pf* pf)
 		if (pf->write_error)
 			return;
 	}
-	write_char_safely(1, '%', pf);
+	write_char_safely('%', pf);
 	if (pf->write_error)
 		return;
 	if (fmt->flags & FLAG_MINUS)
@@ -84,7 +86,7 @@ void format_and_print_c(t_fmt* fmt, va_list* args, t_pf* pf)
 		if (pf->write_error)
 			return;
 	}
-	write_char_safely(1, c, pf);
+	write_char_safely(c, pf);
 	if (pf->write_error)
 		return;
 	if (fmt->flags & FLAG_MINUS)
@@ -129,7 +131,7 @@ void format_and_print_s(t_fmt* fmt, va_list* args, t_pf* pf)
 		if (pf->write_error)
 			return;
 	}
-	write_safely_len(1, str, len, pf);
+	write_safely_len(str, len, pf);
 	if (pf->write_error)
 		return;
 	if (fmt->flags & FLAG_MINUS)
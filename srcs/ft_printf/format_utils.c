@@ -6,8 +6,9 @@
  * This file contains utility functions used during format string interpretation
  * in `ft_printf`. It manages the logic for:
  * - Field width
- * - Padding with spaces or zeroes
+ * - Padding with spaces or zeroes, set in bulk in the output buffer
  * - Precision for strings
+ * - Fields made of a nested format, for custom conversions
  *
  * These functions interact with the `t_fmt` structure (format specifier)
  * and update output state through the `t_pf` structure.
@@ -23,9 +24,10 @@
  * @brief Prints a series of padding characters.
  *
  * @details
- * This function prints `padding` number of characters (typically `' '` or
- * `'0'`) using `write_char_safely`. It is used to align formatted output to the
- * desired width.
+ * This function appends `padding` copies of `pad_char` (typically `' '` or
+ * `'0'`) to the output in one piece, set in the buffer with `ft_memset`
+ * or, past the buffer size, written from a repeated block with `writev`.
+ * It is used to align formatted output to the desired width.
  *
  * If a write error occurs, it sets `pf->write_error`.
  *
@@ -33,17 +35,13 @@
  * @param pad_char Character used for padding (usually ' ' or '0').
  * @param pf Print context to track output and errors.
  *
- * @see write_char_safely
+ * @see write_repeat_safely
  * @ingroup ft_printf
  */
 void print_padding(int padding, char pad_char, t_pf* pf)
 {
-	while (padding-- > 0)
-	{
-		write_char_safely(1, pad_char, pf);
-		if (pf->write_error)
-			return;
-	}
+	if (padding > 0)
+		write_repeat_safely(pad_char, padding, pf);
 }
 
 /**
@@ -88,3 +86,50 @@ int handle_width(t_fmt* fmt, size_t len)
 		return (0);
 	return (padding);
 }
+
+/**
+ * @brief Prints a nested format as one field of the current conversion.
+ *
+ * @details
+ * Meant for custom conversion handlers (`ft_printf_register`): the
+ * nested format is expanded straight into the output of `pf`, then
+ * padded with spaces to the width of `fmt` (on the right with the `-`
+ * flag). When a width is set, the nested format is first run against a
+ * counting sink to learn its length, so the field never goes through an
+ * intermediate buffer.
+ *
+ * @param fmt Format descriptor of the enclosing conversion.
+ * @param pf Print context of the enclosing call.
+ * @param format The nested format string.
+ * @param ... Arguments matching the nested format.
+ *
+ * @see process_format_string
+ * @ingroup ft_printf
+ */
+void ft_printf_field(t_fmt* fmt, t_pf* pf, const char* format, ...)
+{
+	va_list args;
+	t_fmt   outer;
+	t_pf    count;
+	int     padding;
+
+	outer   = *fmt;
+	padding = 0;
+	if (outer.width > 0)
+	{
+		initialize_printf_structs(&count);
+		count.sink = PF_SINK_MEM;
+		va_start(args, format);
+		process_format_string(format, &args, &count);
+		va_end(args);
+		padding = handle_width(&outer, count.total);
+	}
+	if (!(outer.flags & FLAG_MINUS))
+		print_padding(padding, ' ', pf);
+	va_start(args, format);
+	process_format_string(format, &args, pf);
+	va_end(args);
+	if (outer.flags & FLAG_MINUS)
+		print_padding(padding, ' ', pf);
+	*fmt = outer;
+}
@@ -0,0 +1,336 @@
+/**
+ * @file ft_dprintf.c
+ * @brief `ft_printf` to any file descriptor, with per-descriptor buffers.
+ *
+ * @details
+ * `ft_dprintf` formats into a buffer that belongs to the target file
+ * descriptor and outlives the call. Output only reaches the descriptor
+ * when that buffer is full, when `ft_fflush` is called, or at program
+ * exit, so high-rate logging is batched into `PF_FD_BUF_SIZE` writes.
+ *
+ * The buffers live in a table indexed by descriptor that grows on demand.
+ * An `atexit` handler flushes and frees them when the program exits
+ * normally; calls made after it, from a later exit handler or a
+ * destructor, are written at once. If a buffer cannot be allocated, the
+ * call is also written at once, like `ft_printf`.
+ *
+ * The buffers are shared between threads, so a mutex guards the table.
+ * Each call formats into its own stack buffer first, with no lock held,
+ * then takes the lock only to append the result to the descriptor's
+ * buffer (writing it out when full). Formatting on several threads
+ * therefore runs in parallel, and a custom conversion handler may call
+ * `ft_dprintf` itself. An atomic bitmap records which descriptors have
+ * bytes pending, so the flush `ft_printf` does first takes no lock
+ * unless standard output actually has buffered output.
+ *
+ * @author Toonsa
+ * @date 2026/10/19
+ * @ingroup ft_printf
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Returns the process-wide table of descriptor buffers.
+ *
+ * @ingroup ft_printf
+ */
+static t_pf_fdbufs* fdbuf_table(void)
+{
+	static t_pf_fdbufs table = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+	return (&table);
+}
+
+/**
+ * @brief Updates the pending bit of a descriptor after its buffer
+ *        changed.
+ *
+ * @details
+ * The caller holds the table lock. Descriptors past the bitmap are not
+ * tracked and always go through the lock.
+ *
+ * @param table The descriptor buffer table.
+ * @param fd The descriptor.
+ *
+ * @ingroup ft_printf
+ */
+static void mark_pending(t_pf_fdbufs* table, int fd)
+{
+	unsigned long long bit;
+
+	if (fd >= PF_PENDING_FDS)
+		return;
+	bit = 1ULL << fd;
+	if (fd < table->count && table->bufs[fd].len > 0)
+		atomic_fetch_or(&table->pending, bit);
+	else
+		atomic_fetch_and(&table->pending, ~bit);
+}
+
+/**
+ * @brief Writes the pending output of one descriptor buffer.
+ *
+ * @details
+ * The caller holds the table lock. Pending bytes are discarded after a
+ * write failure.
+ *
+ * @param table The descriptor buffer table.
+ * @param fd The descriptor to flush.
+ *
+ * @return 0 on success (including when nothing is pending), or `-1` if
+ *         a write failed.
+ *
+ * @see flush_printf_buffer
+ * @ingroup ft_printf
+ */
+static int flush_fdbuf(t_pf_fdbufs* table, int fd)
+{
+	t_pf pf;
+
+	if (fd >= table->count || table->bufs[fd].len == 0)
+		return (0);
+	pf.sink        = PF_SINK_FD;
+	pf.fd          = fd;
+	pf.write_error = 0;
+	pf.buf         = table->bufs[fd].data;
+	pf.len         = table->bufs[fd].len;
+	flush_printf_buffer(&pf);
+	table->bufs[fd].len = 0;
+	mark_pending(table, fd);
+	return ((pf.write_error) ? -1 : 0);
+}
+
+/**
+ * @brief Flushes and frees every descriptor buffer at program exit.
+ *
+ * @details
+ * Marks the table `closed`, so later calls write their output at once
+ * instead of filling a buffer nothing would flush.
+ *
+ * @ingroup ft_printf
+ */
+static void flush_all_at_exit(void)
+{
+	t_pf_fdbufs* table;
+	int          fd;
+
+	table = fdbuf_table();
+	pthread_mutex_lock(&table->lock);
+	fd = 0;
+	while (fd < table->count)
+	{
+		flush_fdbuf(table, fd);
+		free(table->bufs[fd++].data);
+	}
+	free(table->bufs);
+	table->bufs   = NULL;
+	table->count  = 0;
+	table->closed = 1;
+	atomic_store(&table->pending, 0);
+	pthread_mutex_unlock(&table->lock);
+}
+
+/**
+ * @brief Returns the buffer of a descriptor, creating it if needed.
+ *
+ * @details
+ * The table is grown to cover `fd` (at least doubling its size) and the
+ * buffer storage is allocated on first use. The exit handler is
+ * registered together with the first buffer. Once the exit handler has
+ * run, no buffer is handed out. The caller holds the table lock.
+ *
+ * @param table The descriptor buffer table.
+ * @param fd The target file descriptor.
+ *
+ * @return The descriptor's buffer, or NULL on allocation failure or
+ *         after the exit handler.
+ *
+ * @see ft_realloc
+ * @ingroup ft_printf
+ */
+static t_pf_fdbuf* get_fdbuf(t_pf_fdbufs* table, int fd)
+{
+	t_pf_fdbuf* bufs;
+	int         count;
+
+	if (table->closed)
+		return (NULL);
+	if (fd >= table->count)
+	{
+		count = (table->count * 2 > fd) ? table->count * 2 : fd + 1;
+		bufs  = ft_realloc(table->bufs, table->count * sizeof(t_pf_fdbuf),
+		                   count * sizeof(t_pf_fdbuf));
+		if (!bufs)
+			return (NULL);
+		ft_bzero(bufs + table->count,
+		         (count - table->count) * sizeof(t_pf_fdbuf));
+		table->bufs  = bufs;
+		table->count = count;
+	}
+	if (!table->bufs[fd].data)
+	{
+		if (!table->exit_hook && atexit(flush_all_at_exit) != 0)
+			return (NULL);
+		atomic_store(&table->exit_hook, 1);
+		table->bufs[fd].data = malloc(PF_FD_BUF_SIZE);
+	}
+	if (!table->bufs[fd].data)
+		return (NULL);
+	return (&table->bufs[fd]);
+}
+
+/**
+ * @brief Appends the output of one call to its descriptor's buffer.
+ *
+ * @details
+ * Takes the table lock for the append only. When the buffer cannot
+ * take the output, its pending bytes and the output leave together in
+ * one `writev` (or the buffer is written first when the output is
+ * small). Without a buffer, the output is written at once; nothing is
+ * pending for the descriptor then, so the order is kept.
+ *
+ * @param out Formatted output of the call (`out->write_error` is set
+ *            on failure).
+ *
+ * @see write_safely_len
+ * @ingroup ft_printf
+ */
+static void append_to_fdbuf(t_pf* out)
+{
+	t_pf_fdbufs* table;
+	t_pf_fdbuf*  fdbuf;
+	t_pf         pf;
+
+	table = fdbuf_table();
+	pthread_mutex_lock(&table->lock);
+	fdbuf = get_fdbuf(table, out->fd);
+	if (fdbuf)
+	{
+		initialize_printf_structs(&pf);
+		pf.fd   = out->fd;
+		pf.hold = 1;
+		pf.buf  = fdbuf->data;
+		pf.len  = fdbuf->len;
+		pf.cap  = PF_FD_BUF_SIZE;
+		write_safely_len(out->buf, out->len, &pf);
+		fdbuf->len       = pf.len;
+		mark_pending(table, out->fd);
+		out->write_error = pf.write_error;
+		out->len         = 0;
+	}
+	pthread_mutex_unlock(&table->lock);
+	if (!fdbuf)
+		flush_printf_buffer(out);
+}
+
+/**
+ * @brief Prints formatted output to a file descriptor, with a `va_list`.
+ *
+ * @details
+ * The output is formatted into a stack buffer (moved to the heap if it
+ * outgrows it) with no lock held, then appended to the descriptor's
+ * buffer and kept there after the call. It reaches `fd` when the buffer
+ * fills up, on `ft_fflush(fd)`, or at program exit. A write error is
+ * reported by the call that triggers the failing flush. Each append is
+ * made under the table lock, so the output of each call stays
+ * contiguous. If the heap block cannot be allocated, the call fails and
+ * writes nothing: writing part of it early would put it ahead of bytes
+ * still pending in the descriptor's buffer.
+ *
+ * @param fd The target file descriptor.
+ * @param format The format string.
+ * @param args Arguments matching the format specifiers.
+ *
+ * @return The number of characters produced, or `-1` on error.
+ *
+ * @see append_to_fdbuf
+ * @see ft_fflush
+ * @ingroup ft_printf
+ */
+int ft_vdprintf(int fd, const char* format, va_list args)
+{
+	va_list copy;
+	t_pf    pf;
+	char    buf[PF_BUF_SIZE];
+
+	if (fd < 0 || format == NULL)
+		return (-1);
+	initialize_printf_structs(&pf);
+	pf.fd         = fd;
+	pf.must_spill = 1;
+	pf.buf        = buf;
+	pf.cap        = sizeof(buf);
+	va_copy(copy, args);
+	process_format_string(format, &copy, &pf);
+	va_end(copy);
+	if (!pf.write_error && !pf.malloc_error)
+		append_to_fdbuf(&pf);
+	pf.hold = 1;
+	return (finish_printf(&pf));
+}
+
+/**
+ * @brief Prints formatted output to a file descriptor.
+ *
+ * @param fd The target file descriptor.
+ * @param format The format string.
+ * @param ... Arguments matching the format specifiers.
+ *
+ * @return The number of characters produced, or `-1` on error.
+ *
+ * @see ft_vdprintf
+ * @see ft_fflush
+ * @ingroup ft_printf
+ */
+int ft_dprintf(int fd, const char* format, ...)
+{
+	va_list args;
+	int     result;
+
+	va_start(args, format);
+	result = ft_vdprintf(fd, format, args);
+	va_end(args);
+	return (result);
+}
+
+/**
+ * @brief Writes the output `ft_dprintf` holds for a file descriptor.
+ *
+ * @param fd The descriptor to flush, or a negative value to flush every
+ *           descriptor that has pending output.
+ *
+ * @return 0 on success (including when nothing is pending), or `-1` if a
+ *         write failed. Pending bytes are discarded after a failure.
+ *
+ * @see flush_fdbuf
+ * @ingroup ft_printf
+ */
+int ft_fflush(int fd)
+{
+	t_pf_fdbufs* table;
+	int          result;
+
+	table = fdbuf_table();
+	if (!atomic_load(&table->exit_hook))
+		return (0);
+	if (fd >= 0 && fd < PF_PENDING_FDS
+	    && !(atomic_load(&table->pending) & (1ULL << fd)))
+		return (0);
+	pthread_mutex_lock(&table->lock);
+	if (fd >= 0)
+		result = flush_fdbuf(table, fd);
+	else
+	{
+		result = 0;
+		fd     = 0;
+		while (fd < table->count)
+		{
+			if (flush_fdbuf(table, fd) == -1)
+				result = -1;
+			fd++;
+		}
+	}
+	pthread_mutex_unlock(&table->lock);
+	return (result);
+}
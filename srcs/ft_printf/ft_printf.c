@@ -22,15 +22,77 @@
 
 #include "libft.h"
 
+/**
+ * @brief Runs the format engine and finalizes the output sink.
+ *
+ * @details
+ * Shared by every `ft_printf` variant. The caller initializes `pf` with
+ * `initialize_printf_structs` and attaches its sink; this function
+ * formats every argument, then finalizes the sink.
+ *
+ * @param pf Initialized print context with its sink attached.
+ * @param format The format string.
+ * @param args Arguments matching the format specifiers.
+ *
+ * @return The number of characters produced, or `-1` on error.
+ *
+ * @see process_format_string
+ * @see finish_printf
+ * @ingroup ft_printf
+ */
+int print_to_sink(t_pf* pf, const char* format, va_list* args)
+{
+	process_format_string(format, args, pf);
+	return (finish_printf(pf));
+}
+
+/**
+ * @brief Finalizes the output sink at the end of a call.
+ *
+ * @details
+ * Flushes or terminates the sink, unless `pf->hold` keeps the bytes for
+ * a later flush, frees the heap block a one-shot descriptor call may
+ * have spilled to, and turns the error flags into the return value.
+ *
+ * @param pf Print context at the end of formatting.
+ *
+ * @return The number of characters produced, or `-1` on error.
+ *
+ * @see flush_printf_buffer
+ * @ingroup ft_printf
+ */
+int finish_printf(t_pf* pf)
+{
+	if (!pf->hold)
+		flush_printf_buffer(pf);
+	if (pf->spilled)
+	{
+		free(pf->buf);
+		pf->buf     = NULL;
+		pf->spilled = 0;
+	}
+	if (pf->malloc_error || pf->write_error)
+		return (-1);
+	return (pf->total);
+}
+
 /**
  * @brief Prints formatted output according to the format string.
  *
  * @details
  * Mimics the behavior of the standard `printf` function:
  * - Parses the format string
- * - Processes and prints each format specifier with its argument
+ * - Processes and formats each specifier with its argument
  * - Uses internal state via `t_pf` to manage memory and write errors
  *
+ * Output is collected in a `PF_BUF_SIZE` stack buffer and written with a
+ * single `write` at the end of the call; longer output moves to a heap
+ * block and still leaves at once. Calls from several threads therefore
+ * never interleave within a line, and formatting takes no lock: each
+ * call only touches its own buffer. Output that `ft_dprintf` still holds
+ * for standard output is flushed first, so the two keep their relative
+ * order.
+ *
  * If a memory allocation or write operation fails, returns `-1`.
  *
  * @param format The format string (e.g. "Hello %s\n").
@@ -40,31 +102,23 @@
  *
  * @note This function must be passed valid format and matching arguments.
  * @see initialize_printf_structs
- * @see process_format_string
+ * @see print_to_sink
  * @ingroup ft_printf
  */
 int ft_printf(const char* format, ...)
 {
 	va_list args;
-	t_pf*   pf;
-	int     total;
-	int     error;
+	t_pf    pf;
+	char    buf[PF_BUF_SIZE];
+	int     result;
 
-	error = 0;
-	if (format == NULL)
-		return (-1);
-	pf = (t_pf*) malloc(sizeof(t_pf));
-	if (pf == NULL)
-		return (-1);
-	if (initialize_printf_structs(pf) == -1)
+	if (format == NULL || ft_fflush(STDOUT_FILENO) == -1)
 		return (-1);
+	initialize_printf_structs(&pf);
+	pf.buf = buf;
+	pf.cap = sizeof(buf);
 	va_start(args, format);
-	process_format_string(format, &args, pf);
+	result = print_to_sink(&pf, format, &args);
 	va_end(args);
-	total = pf->total;
-	if (pf->malloc_error || pf->write_error)
-		error = -1;
-	free(pf->fmt);
-	free(pf);
-	return (error == -1 ? -1 : total);
+	return (result);
 }
@@ -0,0 +1,289 @@
+/**
+ * @file ft_printf_compile.c
+ * @brief Precompiled format strings for hot formatting loops.
+ *
+ * @details
+ * `ft_printf` parses flags, width and precision of every conversion on
+ * every call. `ft_printf_compile` does that work once and turns the format
+ * into a list of instructions:
+ * - a literal span, copied to the output in one piece
+ * - a conversion, with its `t_fmt` already filled in
+ *
+ * `ft_printf_exec` and `ft_snprintf_exec` then run the program against
+ * their arguments with no parsing left to do. The output is identical to
+ * what `ft_printf` prints for the same format.
+ *
+ * @author Toonsa
+ * @date 2026/10/19
+ * @ingroup ft_printf
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Appends a literal span, merging it with a preceding adjacent one.
+ *
+ * @param prog The program being built.
+ * @param text Start of the span in the program's copy of the format.
+ * @param len Length of the span.
+ *
+ * @ingroup ft_printf
+ */
+static void emit_literal(t_pf_prog* prog, const char* text, size_t len)
+{
+	t_pf_op* last;
+
+	if (len == 0)
+		return;
+	last = (prog->count > 0) ? &prog->ops[prog->count - 1] : NULL;
+	if (last && last->fmt.specifier == '\0' && last->text + last->len == text)
+	{
+		last->len += len;
+		return;
+	}
+	ft_bzero(&prog->ops[prog->count], sizeof(t_pf_op));
+	prog->ops[prog->count].text = text;
+	prog->ops[prog->count].len  = len;
+	prog->count++;
+}
+
+/**
+ * @brief Parses one conversion after `%` into the next instruction.
+ *
+ * @details
+ * Uses the same parser as `ft_printf`. An invalid conversion becomes a
+ * literal span holding the characters consumed, as `ft_printf` prints
+ * them.
+ *
+ * @param prog The program being built.
+ * @param format Cursor just after the `%` (advanced past the conversion).
+ *
+ * @see setup_format
+ * @ingroup ft_printf
+ */
+static void emit_conversion(t_pf_prog* prog, const char** format)
+{
+	const char* start;
+	t_pf_op*    op;
+
+	start = *format - 1;
+	op    = &prog->ops[prog->count];
+	ft_bzero(op, sizeof(t_pf_op));
+	op->fmt.precision = -1;
+	if (setup_format(format, &op->fmt) == -1)
+	{
+		emit_literal(prog, start, *format - start);
+		return;
+	}
+	prog->count++;
+}
+
+/**
+ * @brief Compiles a format string into a reusable program.
+ *
+ * @details
+ * Each `%` yields at most two instructions (the literal before it and the
+ * conversion), which bounds the instruction count so that the program,
+ * its instructions and a private copy of the format fit in one
+ * allocation. The caller's format does not need to outlive the program.
+ *
+ * @param format The format string.
+ *
+ * @return The compiled program, or NULL if `format` is NULL or memory
+ *         allocation fails.
+ *
+ * @note Release the program with `ft_printf_free_compiled`.
+ *
+ * @see ft_printf_exec
+ * @see ft_snprintf_exec
+ * @ingroup ft_printf
+ */
+t_pf_prog* ft_printf_compile(const char* format)
+{
+	t_pf_prog*  prog;
+	size_t      max_ops;
+	size_t      len;
+	const char* text;
+	const char* literal;
+
+	if (format == NULL)
+		return (NULL);
+	max_ops = 1;
+	len     = 0;
+	while (format[len])
+		max_ops += (format[len++] == '%') * 2;
+	prog = malloc(sizeof(t_pf_prog) + max_ops * sizeof(t_pf_op) + len + 1);
+	if (!prog)
+		return (NULL);
+	prog->ops   = (t_pf_op*) (prog + 1);
+	prog->count = 0;
+	text        = ft_memcpy(prog->ops + max_ops, format, len + 1);
+	while (*text)
+	{
+		literal = text;
+		while (*text && *text != '%')
+			text++;
+		emit_literal(prog, literal, text - literal);
+		if (*text == '%' && *++text)
+			emit_conversion(prog, &text);
+	}
+	return (prog);
+}
+
+/**
+ * @brief Releases a program returned by `ft_printf_compile`.
+ *
+ * @param prog The program (NULL is ignored).
+ *
+ * @ingroup ft_printf
+ */
+void ft_printf_free_compiled(t_pf_prog* prog)
+{
+	free(prog);
+}
+
+/**
+ * @brief Runs a compiled program into an initialized print context.
+ *
+ * @details
+ * Literal spans are appended in one copy each; conversions are
+ * dispatched with their precomputed format descriptor. Stops at the
+ * first write or allocation error.
+ *
+ * @param prog The compiled program.
+ * @param args Arguments matching the program's conversions.
+ * @param pf Print context with its sink attached.
+ *
+ * @see parse_and_handle_specifier
+ * @ingroup ft_printf
+ */
+void exec_printf_program(const t_pf_prog* prog, va_list* args, t_pf* pf)
+{
+	const t_pf_op* op;
+	size_t         i;
+
+	i = 0;
+	while (i < prog->count && !pf->write_error && !pf->malloc_error)
+	{
+		op = &prog->ops[i++];
+		if (op->fmt.specifier == '\0')
+			write_safely_len((char*) op->text, op->len, pf);
+		else
+		{
+			pf->fmt = op->fmt;
+			parse_and_handle_specifier(&pf->fmt, args, pf);
+		}
+	}
+}
+
+/**
+ * @brief Runs a compiled program to standard output, with a `va_list`.
+ *
+ * @param prog The compiled program.
+ * @param args Arguments matching the program's conversions.
+ *
+ * @return The number of characters written, or `-1` on error.
+ *
+ * @see ft_printf_exec
+ * @ingroup ft_printf
+ */
+int ft_vprintf_exec(const t_pf_prog* prog, va_list args)
+{
+	va_list copy;
+	t_pf    pf;
+	char    buf[PF_BUF_SIZE];
+
+	if (prog == NULL || ft_fflush(STDOUT_FILENO) == -1)
+		return (-1);
+	initialize_printf_structs(&pf);
+	pf.buf = buf;
+	pf.cap = sizeof(buf);
+	va_copy(copy, args);
+	exec_printf_program(prog, &copy, &pf);
+	va_end(copy);
+	return (finish_printf(&pf));
+}
+
+/**
+ * @brief Runs a compiled program to standard output.
+ *
+ * @details
+ * Prints exactly what `ft_printf` would print for the compiled format,
+ * without parsing it again.
+ *
+ * @param prog The compiled program.
+ * @param ... Arguments matching the program's conversions.
+ *
+ * @return The number of characters written, or `-1` on error.
+ *
+ * @see ft_printf_compile
+ * @ingroup ft_printf
+ */
+int ft_printf_exec(const t_pf_prog* prog, ...)
+{
+	va_list args;
+	int     result;
+
+	va_start(args, prog);
+	result = ft_vprintf_exec(prog, args);
+	va_end(args);
+	return (result);
+}
+
+/**
+ * @brief Runs a compiled program into a caller buffer, with a `va_list`.
+ *
+ * @param str Destination buffer (may be NULL if `size` is 0).
+ * @param size Size of `str` in bytes.
+ * @param prog The compiled program.
+ * @param args Arguments matching the program's conversions.
+ *
+ * @return The length of the full output, or `-1` on error.
+ *
+ * @see ft_vsnprintf
+ * @ingroup ft_printf
+ */
+int ft_vsnprintf_exec(char* str, size_t size, const t_pf_prog* prog,
+                      va_list args)
+{
+	va_list copy;
+	t_pf    pf;
+
+	if (prog == NULL || (str == NULL && size > 0))
+		return (-1);
+	initialize_printf_structs(&pf);
+	pf.sink = PF_SINK_MEM;
+	pf.buf  = (size > 0) ? str : NULL;
+	pf.cap  = (size > 0) ? size - 1 : 0;
+	va_copy(copy, args);
+	exec_printf_program(prog, &copy, &pf);
+	va_end(copy);
+	return (finish_printf(&pf));
+}
+
+/**
+ * @brief Runs a compiled program into a caller buffer.
+ *
+ * @details
+ * Same truncation and return value rules as `ft_snprintf`.
+ *
+ * @param str Destination buffer (may be NULL if `size` is 0).
+ * @param size Size of `str` in bytes.
+ * @param prog The compiled program.
+ * @param ... Arguments matching the program's conversions.
+ *
+ * @return The length of the full output, or `-1` on error.
+ *
+ * @see ft_printf_compile
+ * @ingroup ft_printf
+ */
+int ft_snprintf_exec(char* str, size_t size, const t_pf_prog* prog, ...)
+{
+	va_list args;
+	int     result;
+
+	va_start(args, prog);
+	result = ft_vsnprintf_exec(str, size, prog, args);
+	va_end(args);
+	return (result);
+}
@@ -3,16 +3,16 @@
  * @brief Handles formatting and output of integers in `ft_printf`.
  *
  * @details
- * This module formats and prints integer-based conversions (`%d`, `%i`, `%u`,
- * `%x`, `%X`) according to the format flags provided:
- * - Sign display (`+`, space)
- * - Alternative form (`#`)
- * - Padding (`0`, `-`)
- * - Precision control
+ * This module lays out integer-based conversions (`%d`, `%i`, `%u`, `%x`,
+ * `%X`, `%p`) according to the format flags provided:
+ * - Sign display (`-`, `+`, space) and alternative form (`#`)
+ * - Precision (minimum number of digits)
+ * - Padding (`0`, `-`) up to the field width
  *
- * It builds a final formatted string with prefixes and signs,
- * calculates padding, and outputs everything while tracking
- * write or allocation failures.
+ * Digits are rendered right to left into a small stack buffer (decimal
+ * ones two at a time from a lookup table), and the sign or prefix, the
+ * zeros and the padding are emitted around them straight into the
+ * output sink. No step allocates memory.
  *
  * @author Toonsa
  * @date 2024/10/29
@@ -22,192 +22,149 @@
 #include "libft.h"
 
 /**
- * @brief Prepends a sign character (`+` or space) to a number string.
+ * @brief Renders an unsigned value in decimal, two digits at a time.
  *
  * @details
- * Allocates and returns a new string with the specified sign inserted
- * at the beginning. Frees the old string. Used for `%d` / `%i` formatting.
+ * Each step divides by 100 and copies both digits from a table of the
+ * pairs `"00"` to `"99"`, halving the number of divisions. Once the
+ * value fits 32 bits the loop switches to 32-bit arithmetic, whose
+ * division by a constant is cheaper. Digits are written backwards,
+ * ending just before `end`.
  *
- * @param str The numeric string to modify (will be freed).
- * @param sign The character to prepend (`+` or `' '`).
- * @param pf Pointer to the printf context (for error tracking).
+ * @param value The value to render.
+ * @param end One past the last byte of the destination.
  *
- * @return Newly allocated string with prepended sign, or `NULL` on error.
+ * @return A pointer to the first digit.
  *
- * @see ft_strlcpy
+ * @see render_unsigned
  * @ingroup ft_printf
  */
-static char* prepend_sign(char* str, char sign, t_pf* pf)
+char* render_decimal(uint64_t value, char* end)
 {
-	int   len;
-	char* new_str;
+	static const char pairs[201] =
+	    "0001020304050607080910111213141516171819"
+	    "2021222324252627282930313233343536373839"
+	    "4041424344454647484950515253545556575859"
+	    "6061626364656667686970717273747576777879"
+	    "8081828384858687888990919293949596979899";
+	char*             start;
+	uint32_t          low;
+	int               pair;
 
-	if (!str)
-		return (NULL);
-	len     = ft_strlen(str);
-	new_str = malloc(len + 2);
-	if (!new_str)
+	start = end;
+	while (value > UINT32_MAX)
 	{
-		pf->malloc_error = 1;
-		free(str);
-		return (NULL);
+		pair = (value % 100) * 2;
+		value /= 100;
+		*--start = pairs[pair + 1];
+		*--start = pairs[pair];
 	}
-	new_str[0] = sign;
-	ft_strlcpy(new_str + 1, str, len + 1);
-	free(str);
-	return (new_str);
-}
-
-/**
- * @brief Applies `+`, space, and `#` flags to the formatted number.
- *
- * @details
- * Prepends signs or prefixes to the string depending on format specifier
- * and flags. Updates string length accordingly.
- *
- * @param pf The current printf state.
- * @param str Pointer to the number string (malloc'd).
- * @param len Pointer to its length (will be updated).
- *
- * @return Newly formatted string with all flags applied, or `NULL` on error.
- *
- * @see prepend_sign
- * @see prepend_alternative_form
- * @see requires_alternative_form
- * @see get_alternative_form_length
- * @ingroup ft_printf
- */
-static char* apply_plus_space_hash_flags(t_pf* pf, char* str, int* len)
-{
-	if ((pf->fmt->specifier == 'd' || pf->fmt->specifier == 'i') &&
-	    (pf->fmt->flags & FLAG_PLUS) && ft_isstrpositive(str))
-	{
-		str = prepend_sign(str, '+', pf);
-		if (!str)
-			return (NULL);
-		(*len)++;
-	}
-	else if ((pf->fmt->specifier == 'd' || pf->fmt->specifier == 'i') &&
-	         (pf->fmt->flags & FLAG_SPACE) && ft_isstrpositive(str))
+	low = (uint32_t) value;
+	while (low >= 100)
 	{
-		str = prepend_sign(str, ' ', pf);
-		if (!str)
-			return (NULL);
-		(*len)++;
+		pair = (low % 100) * 2;
+		low /= 100;
+		*--start = pairs[pair + 1];
+		*--start = pairs[pair];
 	}
-	if ((pf->fmt->flags & FLAG_HASH) &&
-	    requires_alternative_form(pf->fmt->specifier, str))
+	if (low >= 10)
 	{
-		str = prepend_alternative_form(str, pf->fmt->specifier, pf);
-		if (!str)
-			return (NULL);
-		*len += get_alternative_form_length(pf->fmt->specifier);
+		*--start = pairs[low * 2 + 1];
+		*--start = pairs[low * 2];
 	}
-	return (str);
+	else
+		*--start = '0' + low;
+	return (start);
 }
 
 /**
- * @brief Writes the number string with left/right padding.
+ * @brief Renders an unsigned value in a given base.
  *
- * @param pf The current printf context.
- * @param str The string to print.
- * @param padding Number of padding spaces.
+ * @details
+ * Digits are written backwards, ending just before `end`, so the caller
+ * gets them without a reversal step. `end` must have at least
+ * `PF_NUM_BUF_SIZE` bytes of room before it. Base 10 goes through
+ * `render_decimal` and base 16 uses shifts, so neither divides by a
+ * variable base.
  *
- * @see write_safely
- * @see print_padding
- * @ingroup ft_printf
- */
-static void print_with_padding(t_pf* pf, char* str, int padding)
-{
-	if (!(pf->fmt->flags & FLAG_MINUS) && !(pf->fmt->flags & FLAG_ZERO))
-	{
-		print_padding(padding, ' ', pf);
-		if (pf->write_error)
-			return;
-	}
-	write_safely(1, str, pf);
-	if (pf->write_error)
-		return;
-	if (pf->fmt->flags & FLAG_MINUS)
-	{
-		print_padding(padding, ' ', pf);
-		if (pf->write_error)
-			return;
-	}
-}
-
-/**
- * @brief Writes zero-padding and handles printing the sign first if needed.
+ * @param value The value to render.
+ * @param base The numeric base (2 to 16).
+ * @param digits The digit characters (e.g. `"0123456789abcdef"`).
+ * @param end One past the last byte of the destination.
  *
- * @param padding Amount of zeros to pad.
- * @param str_ptr Pointer to the string pointer (adjusted if sign is printed).
- * @param pf The printf state.
+ * @return A pointer to the first digit.
  *
- * @see write_char_safely
+ * @see render_decimal
  * @ingroup ft_printf
  */
-static void print_zero_padding_int(int padding, char** str_ptr, t_pf* pf)
+char* render_unsigned(uint64_t value, unsigned int base, const char* digits,
+                      char* end)
 {
-	int sign;
+	char* start;
 
-	sign =
-	    ((*str_ptr)[0] == '-' || (*str_ptr)[0] == '+' || (*str_ptr)[0] == ' ');
-	if (padding <= 0)
-		return;
-	if (sign)
+	if (base == 10)
+		return (render_decimal(value, end));
+	start = end;
+	if (base == 16)
 	{
-		write_char_safely(1, **str_ptr, pf);
-		if (pf->write_error)
-			return;
-		(*str_ptr)++;
+		do
+		{
+			*--start = digits[value & 15];
+			value >>= 4;
+		} while (value != 0);
+		return (start);
 	}
-	while (padding--)
+	do
 	{
-		write_char_safely(1, '0', pf);
-		if (pf->write_error)
-			return;
-	}
+		*--start = digits[value % base];
+		value /= base;
+	} while (value != 0);
+	return (start);
 }
 
 /**
- * @brief Final formatter and dispatcher for integer output.
+ * @brief Prints a rendered number with its prefix, precision and padding.
  *
  * @details
- * This function prepares a number string for printing by applying:
- * - flags (`+`, ` `, `#`)
- * - width / zero-padding
- * - left/right alignment
+ * The output is laid out as `[spaces][prefix][zeros][digits][spaces]`:
+ * - zeros bring the digits up to the precision
+ * - the `0` flag, when no precision is given, turns the left padding
+ *   into zeros placed after the prefix
+ * - the `-` flag moves the padding to the right
  *
- * It prints the fully formatted number and handles memory cleanup.
+ * A precision of 0 with the value 0 prints no digit: callers pass a
+ * length of 0 in that case.
  *
  * @param fmt The current format descriptor.
- * @param str Malloc'd number string to format.
- * @param len Initial string length.
+ * @param prefix Sign or base prefix (`"-"`, `"+"`, `" "`, `"0x"`, ...).
+ * @param digits The rendered digits.
+ * @param len Number of digits.
  * @param pf The printf context for output state tracking.
  *
+ * @see print_padding
  * @ingroup ft_printf
  */
-void print_formatted_number(t_fmt* fmt, char* str, int len, t_pf* pf)
+void print_formatted_number(t_fmt* fmt, const char* prefix, const char* digits,
+                            int len, t_pf* pf)
 {
-	int   padding;
-	char* formatted_str;
-	char* temp_ptr;
+	int prefix_len;
+	int zeros;
+	int padding;
 
-	formatted_str = apply_plus_space_hash_flags(pf, str, &len);
-	if (!formatted_str)
-		return;
-	padding  = handle_width(fmt, len);
-	temp_ptr = formatted_str;
+	prefix_len = ft_strlen(prefix);
+	zeros      = (fmt->precision > len) ? fmt->precision - len : 0;
+	padding    = handle_width(fmt, prefix_len + zeros + len);
 	if ((fmt->flags & FLAG_ZERO) && !(fmt->flags & FLAG_MINUS) &&
 	    fmt->precision < 0)
 	{
-		print_zero_padding_int(padding, &temp_ptr, pf);
-		if (pf->write_error)
-			return;
-		write_safely(1, temp_ptr, pf);
+		zeros += padding;
+		padding = 0;
 	}
-	else
-		print_with_padding(pf, formatted_str, padding);
-	if (!pf->write_error)
-		free(formatted_str);
+	if (!(fmt->flags & FLAG_MINUS))
+		print_padding(padding, ' ', pf);
+	write_safely_len((char*) prefix, prefix_len, pf);
+	print_padding(zeros, '0', pf);
+	write_safely_len((char*) digits, len, pf);
+	if (fmt->flags & FLAG_MINUS)
+		print_padding(padding, ' ', pf);
 }
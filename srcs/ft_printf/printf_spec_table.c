@@ -0,0 +1,118 @@
+/**
+ * @file printf_spec_table.c
+ * @brief Character table driving format parsing and dispatch.
+ *
+ * @details
+ * Every byte that can follow a `%` has one entry in a 256-entry table:
+ * - flag characters carry their `FLAG_*` bit
+ * - length modifier characters carry their `PF_LEN_*` value (`hh` and
+ *   `ll` are recognised by the parser from a repeated `h` or `l`)
+ * - conversion specifiers carry their handler
+ * - every other byte has neither, and ends the conversion as invalid
+ *
+ * `setup_format` reads the flag bits and checks specifiers with one load
+ * per character, and `parse_and_handle_specifier` calls the handler with
+ * one indexed call instead of a chain of comparisons. Adding a specifier
+ * only takes a new entry, and `ft_printf_register` lets applications add
+ * their own at run time.
+ *
+ * @author Toonsa
+ * @date 2026/10/19
+ * @ingroup ft_printf
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Returns the writable specifier table.
+ *
+ * @return A pointer to the 256 entries of the table.
+ *
+ * @ingroup ft_printf
+ */
+static t_pf_spec* spec_table(void)
+{
+	static t_pf_spec specs[256] = {
+	    ['#'] = {NULL, FLAG_HASH, PF_LEN_NONE},
+	    ['0'] = {NULL, FLAG_ZERO, PF_LEN_NONE},
+	    ['-'] = {NULL, FLAG_MINUS, PF_LEN_NONE},
+	    ['+'] = {NULL, FLAG_PLUS, PF_LEN_NONE},
+	    [' '] = {NULL, FLAG_SPACE, PF_LEN_NONE},
+	    ['h'] = {NULL, 0, PF_LEN_H},
+	    ['l'] = {NULL, 0, PF_LEN_L},
+	    ['j'] = {NULL, 0, PF_LEN_J},
+	    ['z'] = {NULL, 0, PF_LEN_Z},
+	    ['t'] = {NULL, 0, PF_LEN_T},
+	    ['c'] = {format_and_print_c, 0, PF_LEN_NONE},
+	    ['s'] = {format_and_print_s, 0, PF_LEN_NONE},
+	    ['p'] = {format_and_print_p, 0, PF_LEN_NONE},
+	    ['d'] = {format_and_print_id, 0, PF_LEN_NONE},
+	    ['i'] = {format_and_print_id, 0, PF_LEN_NONE},
+	    ['u'] = {format_and_print_u, 0, PF_LEN_NONE},
+	    ['x'] = {format_and_print_x, 0, PF_LEN_NONE},
+	    ['X'] = {format_and_print_x, 0, PF_LEN_NONE},
+	    ['f'] = {format_and_print_f, 0, PF_LEN_NONE},
+	    ['F'] = {format_and_print_f, 0, PF_LEN_NONE},
+	    ['e'] = {format_and_print_e, 0, PF_LEN_NONE},
+	    ['E'] = {format_and_print_e, 0, PF_LEN_NONE},
+	    ['g'] = {format_and_print_g, 0, PF_LEN_NONE},
+	    ['G'] = {format_and_print_g, 0, PF_LEN_NONE},
+	    ['a'] = {format_and_print_a, 0, PF_LEN_NONE},
+	    ['A'] = {format_and_print_a, 0, PF_LEN_NONE},
+	    ['%'] = {format_and_print_percent, 0, PF_LEN_NONE},
+	};
+
+	return (specs);
+}
+
+/**
+ * @brief Returns the specifier table, indexed by unsigned character.
+ *
+ * @return A pointer to the 256 entries of the table.
+ *
+ * @see setup_format
+ * @see parse_and_handle_specifier
+ * @ingroup ft_printf
+ */
+const t_pf_spec* get_printf_specs(void)
+{
+	return (spec_table());
+}
+
+/**
+ * @brief Installs a handler for a custom conversion specifier.
+ *
+ * @details
+ * Once registered, `%<spec>` in any `ft_printf` format (with flags,
+ * width, precision and length modifier parsed as usual) calls `handler`
+ * with the parsed `t_fmt`, the argument list and the print context. The
+ * handler fetches its own arguments with `va_arg` and writes straight
+ * into the output through `write_safely_len`, `print_padding` or
+ * `ft_printf_field`, so no intermediate string is needed.
+ *
+ * The built-in conversions, flags, length modifiers, digits and `.`
+ * cannot be taken over.
+ *
+ * @param spec The specifier character.
+ * @param handler The handler, or NULL to remove a custom specifier.
+ *
+ * @return 0 on success, -1 if `spec` cannot be registered.
+ *
+ * @note The table is not locked: register handlers before any thread
+ *       starts printing. `ft_log_binary` does not know the arguments of
+ *       a custom conversion and formats such messages as text instead.
+ *
+ * @see format_and_print_point
+ * @ingroup ft_printf
+ */
+int ft_printf_register(char spec, t_pf_handler handler)
+{
+	t_pf_spec* entry;
+
+	entry = &spec_table()[(unsigned char) spec];
+	if (spec == '\0' || spec == '.' || ft_isdigit(spec) || entry->flag ||
+	    entry->length != PF_LEN_NONE || ft_strchr("cspdiuxXfFeEgGaA%", spec))
+		return (-1);
+	entry->handler = handler;
+	return (0);
+}
@@ -8,7 +8,9 @@
  * resets formatting context, and dispatches printing to the appropriate
  * handler functions based on the type.
  *
- * Supported specifiers: `%c`, `%s`, `%d`, `%i`, `%u`, `%x`, `%X`, `%%`.
+ * Supported specifiers: `%c`, `%s`, `%p`, `%d`, `%i`, `%u`, `%x`, `%X`,
+ * `%f`, `%F`, `%e`, `%E`, `%g`, `%G`, `%a`, `%A`, `%%`, with the length
+ * modifiers `hh`, `h`, `l`, `ll`, `j`, `z` and `t` on integers.
  *
  * @author Toonsa
  * @date 2024/10/30
@@ -20,34 +22,25 @@
 /**
  * @brief Delegates the specifier to the appropriate formatter.
  *
+ * @details
+ * The handler is looked up in the specifier table with a single indexed
+ * load. Shared by the format interpreter below and by compiled programs
+ * (`exec_printf_program`).
+ *
  * @param fmt Current format context (`t_fmt`).
  * @param args Active variadic argument list.
  * @param pf Print state tracker (`t_pf`).
  *
- * @see format_and_print_c
- * @see format_and_print_s
- * @see format_and_print_id
- * @see format_and_print_u
- * @see format_and_print_x
- * @see format_and_print_percent
+ * @see get_printf_specs
  * @ingroup ft_printf
  */
-static void parse_and_handle_specifier(t_fmt* fmt, va_list* args, t_pf* pf)
+void parse_and_handle_specifier(t_fmt* fmt, va_list* args, t_pf* pf)
 {
-	if (fmt->specifier == 'c')
-		format_and_print_c(fmt, args, pf);
-	else if (fmt->specifier == 's')
-		format_and_print_s(fmt, args, pf);
-	else if (fmt->specifier == 'i' || fmt->specifier == 'd')
-		format_and_print_id(fmt, args, pf);
-	else if (fmt->specifier == 'u')
-		format_and_print_u(fmt, args, pf);
-	else if (fmt->specifier == 'x')
-		format_and_print_x(fmt, args, 0, pf);
-	else if (fmt->specifier == 'X')
-		format_and_print_x(fmt, args, 1, pf);
-	else if (fmt->specifier == '%')
-		format_and_print_percent(fmt, pf);
+	t_pf_handler handler;
+
+	handler = get_printf_specs()[(unsigned char) fmt->specifier].handler;
+	if (handler)
+		handler(fmt, args, pf);
 }
 
 /**
@@ -62,6 +55,7 @@ static void reset_fmt(t_fmt* fmt)
 	fmt->flags     = 0;
 	fmt->width     = 0;
 	fmt->precision = -1;
+	fmt->length    = PF_LEN_NONE;
 	fmt->specifier = '\0';
 }
 
@@ -72,8 +66,7 @@ static void reset_fmt(t_fmt* fmt)
  * This function processes the format string starting from the current
  * cursor. It resets the format context, sets up the format
  * descriptor, and dispatches the appropriate formatter.
- * If the format is invalid, it prints the raw characters until the
- * next `%` or end of string.
+ * If the format is invalid, it prints the raw characters consumed so far.
  *
  * @param format Pointer to the current cursor in the format string.
  * @param args Argument list used for conversions.
@@ -82,27 +75,21 @@ static void reset_fmt(t_fmt* fmt)
  * @see setup_format
  * @see reset_fmt
  * @see parse_and_handle_specifier
- * @see write_char_safely
+ * @see write_safely_len
  * @ingroup ft_printf
  */
 static void process_conv_spec(const char** format, va_list* args, t_pf* pf)
 {
 	const char* start_format;
 
-	reset_fmt(pf->fmt);
+	reset_fmt(&pf->fmt);
 	start_format = *format - 1;
-	if (setup_format(format, pf->fmt) == -1)
+	if (setup_format(format, &pf->fmt) == -1)
 	{
-		while (start_format < *format)
-		{
-			write_char_safely(1, *start_format, pf);
-			if (pf->write_error != 0)
-				return;
-			start_format++;
-		}
+		write_safely_len((char*) start_format, *format - start_format, pf);
 		return;
 	}
-	parse_and_handle_specifier(pf->fmt, args, pf);
+	parse_and_handle_specifier(&pf->fmt, args, pf);
 }
 
 /**
@@ -111,18 +98,21 @@ static void process_conv_spec(const char** format, va_list* args, t_pf* pf)
  * @details
  * This is the main format processing loop for `ft_printf`. It iterates
  * through the characters in the format string. When encountering `%`,
- * it parses and processes a specifier. Otherwise, it prints the character.
+ * it parses and processes a specifier. Otherwise, it appends the whole
+ * run of literal characters up to the next `%` in one copy.
  *
  * @param format The format string to parse.
  * @param args The active variadic arguments.
  * @param pf Print state context.
  *
  * @see process_conv_spec
- * @see write_char_safely
+ * @see write_safely_len
  * @ingroup ft_printf
  */
 void process_format_string(const char* format, va_list* args, t_pf* pf)
 {
+	const char* literal;
+
 	while (*format)
 	{
 		if (*format == '%')
@@ -136,10 +126,12 @@ void process_format_string(const char* format, va_list* args, t_pf* pf)
 		}
 		else
 		{
-			write_char_safely(1, *format, pf);
+			literal = format;
+			while (*format && *format != '%')
+				format++;
+			write_safely_len((char*) literal, format - literal, pf);
 			if (pf->write_error != 0)
 				return;
-			format++;
 		}
 	}
 }
@@ -4,11 +4,14 @@
  *
  * @details
  * This module extracts formatting instructions (flags, width,
- * precision, and specifier) from the format string and stores them
- * into a `t_fmt` structure for use by the `ft_printf` handlers.
+ * precision, length modifier, and specifier) from the format string and
+ * stores them into a `t_fmt` structure for use by the `ft_printf`
+ * handlers.
  *
  * Supported flags: `#`, `0`, `-`, `+`, ` `
- * Supported specifiers: `%`, `c`, `s`, `p`, `d`, `i`, `u`, `x`, `X`
+ * Supported length modifiers: `hh`, `h`, `l`, `ll`, `j`, `z`, `t`
+ * Supported specifiers: `%`, `c`, `s`, `p`, `d`, `i`, `u`, `x`, `X`,
+ * `f`, `F`, `e`, `E`, `g`, `G`, `a`, `A`
  *
  * @author Toonsa
  * @date 2024/10/15
@@ -20,29 +23,27 @@
 /**
  * @brief Parses format flags and sets corresponding bits.
  *
- * Flags include: `#`, `0`, `-`, `+`, and space.
+ * Flags include: `#`, `0`, `-`, `+`, and space. Each character's bit is
+ * read from the specifier table; bytes that are not flags have none.
  *
  * @param format Format string pointer (will be advanced).
  * @param fmt Target format context.
+ * @param specs The specifier table.
  *
- * @see is_valid_flag
+ * @see get_printf_specs
  * @ingroup ft_printf
  */
-static void parse_flags(const char** format, t_fmt* fmt)
+static void parse_flags(const char** format, t_fmt* fmt,
+                        const t_pf_spec* specs)
 {
-	while (**format && is_valid_flag(**format))
+	int flag;
+
+	flag = specs[(unsigned char) **format].flag;
+	while (flag)
 	{
-		if (**format == '#')
-			fmt->flags |= FLAG_HASH;
-		else if (**format == '0')
-			fmt->flags |= FLAG_ZERO;
-		else if (**format == '-')
-			fmt->flags |= FLAG_MINUS;
-		else if (**format == '+')
-			fmt->flags |= FLAG_PLUS;
-		else if (**format == ' ')
-			fmt->flags |= FLAG_SPACE;
+		fmt->flags |= flag;
 		(*format)++;
+		flag = specs[(unsigned char) **format].flag;
 	}
 }
 
@@ -92,24 +93,59 @@ static void parse_precision(const char** format, t_fmt* fmt)
 	}
 }
 
+/**
+ * @brief Parses a length modifier (e.g., `%ld`, `%hhx`, `%zu`).
+ *
+ * The modifier is read from the specifier table; a repeated `h` or `l`
+ * gives `hh` or `ll`. Without a modifier, `fmt->length` is
+ * `PF_LEN_NONE`.
+ *
+ * @param format Format string pointer (will be advanced).
+ * @param fmt Target format context.
+ * @param specs The specifier table.
+ *
+ * @see get_printf_specs
+ * @ingroup ft_printf
+ */
+static void parse_length(const char** format, t_fmt* fmt,
+                         const t_pf_spec* specs)
+{
+	char c;
+
+	c           = **format;
+	fmt->length = specs[(unsigned char) c].length;
+	if (fmt->length == PF_LEN_NONE)
+		return;
+	(*format)++;
+	if (**format == c && fmt->length == PF_LEN_H)
+		fmt->length = PF_LEN_HH;
+	else if (**format == c && fmt->length == PF_LEN_L)
+		fmt->length = PF_LEN_LL;
+	else
+		return;
+	(*format)++;
+}
+
 /**
  * @brief Validates and stores the conversion specifier.
  *
- * Accepted specifiers: `c`, `s`, `p`, `d`, `i`, `u`, `x`, `X`, `%`
+ * A character is a specifier when the specifier table has a handler for
+ * it: `c`, `s`, `p`, `d`, `i`, `u`, `x`, `X`, the floating-point
+ * conversions, `%`.
  *
  * @param format Format string pointer (will be advanced).
  * @param fmt Target format context.
+ * @param specs The specifier table.
  *
  * @return 0 if valid, -1 if unknown specifier.
  *
- * @see ft_strchr
+ * @see get_printf_specs
  * @ingroup ft_printf
  */
-static int parse_specifier(const char** format, t_fmt* fmt)
+static int parse_specifier(const char** format, t_fmt* fmt,
+                           const t_pf_spec* specs)
 {
-	if (**format == '\0')
-		return (-1);
-	if (ft_strchr("cspdiuxX%", **format))
+	if (specs[(unsigned char) **format].handler)
 	{
 		fmt->specifier = **format;
 		(*format)++;
@@ -121,7 +157,7 @@ static int parse_specifier(const char** format, t_fmt* fmt)
 
 /**
  * @brief Parses a full format specification (flags, width, precision,
- * specifier).
+ * length modifier, specifier).
  *
  * @details
  * Parses from `%` until the final specifier character. Populates the given
@@ -135,15 +171,20 @@ static int parse_specifier(const char** format, t_fmt* fmt)
  * @see parse_flags
  * @see parse_width
  * @see parse_precision
+ * @see parse_length
  * @see parse_specifier
  * @ingroup ft_printf
  */
 int setup_format(const char** format, t_fmt* fmt)
 {
-	parse_flags(format, fmt);
+	const t_pf_spec* specs;
+
+	specs = get_printf_specs();
+	parse_flags(format, fmt, specs);
 	parse_width(format, fmt);
 	parse_precision(format, fmt);
-	if (parse_specifier(format, fmt) == -1)
+	parse_length(format, fmt, specs);
+	if (parse_specifier(format, fmt, specs) == -1)
 		return (-1);
 	return (0);
 }
@@ -1,16 +1,25 @@
 /**
  * @file write_safely.c
- * @brief Safe low-level write utilities for ft_printf.
+ * @brief Output sink utilities for ft_printf.
  *
  * @details
- * This file implements safe wrappers around the `write` system call
- * used by `ft_printf`. It ensures that:
+ * This file implements the output layer shared by every `ft_printf`
+ * variant. Formatted bytes are appended to the buffer held by `t_pf`,
+ * and what happens when that buffer is full depends on its sink:
+ * - `PF_SINK_FD`: a call that holds its output (`ft_dprintf`) writes the
+ *   buffer to the file descriptor; any other call moves its output to a
+ *   larger heap block, so the whole call leaves in a single `write` and
+ *   cannot interleave with the output of other threads. If that block
+ *   cannot be allocated, the buffer is written early, unless the call
+ *   must spill, in which case it fails
+ * - `PF_SINK_MEM`: the extra bytes are counted but dropped
+ * - `PF_SINK_ALLOC`: the buffer grows
+ *
+ * It ensures that:
  * - All bytes are written even if the syscall is interrupted
  * - Errors are tracked through the `t_pf` structure
- * - Output progress (`total`) is updated reliably
- *
- * These utilities are essential for robust and portable output handling
- * when implementing a printf-like function.
+ * - Output progress (`total`) counts every byte produced, including the
+ *   ones a full `PF_SINK_MEM` buffer had to drop
  *
  * @author Toonsa
  * @date 2024/11/30
@@ -18,35 +27,44 @@
  */
 
 #include "libft.h"
+#include <sys/uio.h>
+
+/**
+ * @brief Initial capacity of a `PF_SINK_ALLOC` buffer.
+ */
+#define PF_ALLOC_MIN 64
+
+/**
+ * @brief Size of the block a long run of padding is written from.
+ */
+#define PF_PAD_BLOCK 4096
+
+/**
+ * @brief Most chunks handed to one `writev`.
+ */
+#define PF_IOV_MAX 256
 
 /**
- * @brief Safely writes a null-terminated string to a file descriptor.
+ * @brief Writes a batch of chunks to the output file descriptor.
  *
  * @details
- * This function ensures the full content of `str` is written to `fd`,
- * handling partial writes and interruptions caused by signals (`EINTR`).
- * Updates the `total` field in `t_pf` and sets `write_error` on failure.
+ * The chunks leave in one `writev`. Handles partial writes and
+ * interruptions caused by signals (`EINTR`) by resuming where the kernel
+ * stopped. Sets `write_error` on failure.
  *
- * @param fd File descriptor to write to.
- * @param str Null-terminated string to write.
  * @param pf Pointer to printf state context (`t_pf`).
+ * @param iov The chunks (modified on partial writes).
+ * @param count Number of chunks.
  *
- * @see ft_strlen
  * @ingroup ft_printf
  */
-void write_safely(int fd, char* str, t_pf* pf)
+static void write_all(t_pf* pf, struct iovec* iov, int count)
 {
 	ssize_t bytes_written;
-	size_t  total_written;
-	size_t  len;
 
-	if (str == NULL)
-		return;
-	total_written = 0;
-	len           = ft_strlen(str);
-	while (total_written < len)
+	while (count > 0)
 	{
-		bytes_written = write(fd, str + total_written, len - total_written);
+		bytes_written = writev(pf->fd, iov, count);
 		if (bytes_written == -1)
 		{
 			if (errno == EINTR)
@@ -54,75 +72,365 @@ void write_safely(int fd, char* str, t_pf* pf)
 			pf->write_error = 1;
 			return;
 		}
-		total_written += bytes_written;
+		while (count > 0 && (size_t) bytes_written >= iov->iov_len)
+		{
+			bytes_written -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0)
+		{
+			iov->iov_base = (char*) iov->iov_base + bytes_written;
+			iov->iov_len -= bytes_written;
+		}
+	}
+}
+
+/**
+ * @brief Writes the pending buffer followed by `len` bytes of `str`.
+ *
+ * @details
+ * Used for a chunk too large for the buffer of a `PF_SINK_FD` call:
+ * both leave in a single `writev`, without copying the chunk. After a
+ * write error nothing is written. The buffer is left empty.
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ * @param str Bytes to write after the buffer.
+ * @param len Number of bytes.
+ *
+ * @ingroup ft_printf
+ */
+static void write_through(t_pf* pf, char* str, size_t len)
+{
+	struct iovec iov[2];
+
+	if (!pf->write_error)
+	{
+		iov[0].iov_base = pf->buf;
+		iov[0].iov_len  = pf->len;
+		iov[1].iov_base = str;
+		iov[1].iov_len  = len;
+		write_all(pf, iov, 2);
+	}
+	pf->len = 0;
+}
+
+/**
+ * @brief Writes the pending buffer followed by `n` copies of `c`.
+ *
+ * @details
+ * The copies come from one `PF_PAD_BLOCK`-byte block repeated across the
+ * `iovec` array, so a run of `PF_IOV_MAX - 1` blocks costs one
+ * `writev`. After a write error nothing is written. The buffer is left
+ * empty.
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ * @param c Character to repeat.
+ * @param n Number of copies.
+ *
+ * @see write_repeat_safely
+ * @ingroup ft_printf
+ */
+static void write_repeated(t_pf* pf, char c, size_t n)
+{
+	struct iovec iov[PF_IOV_MAX];
+	char         block[PF_PAD_BLOCK];
+	int          count;
+
+	ft_memset(block, c, sizeof(block));
+	iov[0].iov_base = pf->buf;
+	iov[0].iov_len  = pf->len;
+	count           = 1;
+	while (n > 0 && !pf->write_error)
+	{
+		iov[count].iov_base = block;
+		iov[count].iov_len  = (n < sizeof(block)) ? n : sizeof(block);
+		n -= iov[count++].iov_len;
+		if (count == PF_IOV_MAX || n == 0)
+		{
+			write_all(pf, iov, count);
+			count = 0;
+		}
+	}
+	pf->len = 0;
+}
+
+/**
+ * @brief Grows a `PF_SINK_ALLOC` buffer to hold `want` more bytes.
+ *
+ * @details
+ * The capacity at least doubles, so appending n bytes costs amortized
+ * O(n). One extra byte is always allocated for the null terminator.
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ * @param want Number of bytes about to be appended.
+ *
+ * @return 0 on success, -1 (with `malloc_error` set) on failure.
+ *
+ * @see ft_realloc
+ * @ingroup ft_printf
+ */
+static int grow_buffer(t_pf* pf, size_t want)
+{
+	size_t new_cap;
+	char*  new_buf;
+
+	new_cap = (pf->cap < PF_ALLOC_MIN) ? PF_ALLOC_MIN : pf->cap * 2;
+	if (new_cap < pf->len + want)
+		new_cap = pf->len + want;
+	new_buf = ft_realloc(pf->buf, pf->len, new_cap + 1);
+	if (!new_buf)
+	{
+		pf->malloc_error = 1;
+		return (-1);
 	}
-	pf->total += total_written;
+	pf->buf = new_buf;
+	pf->cap = new_cap;
+	return (0);
+}
+
+/**
+ * @brief Moves the output of a one-shot `PF_SINK_FD` call to the heap.
+ *
+ * @details
+ * The call's stack buffer is full: its content moves to a heap block of
+ * at least twice the size, owned by the call and freed by
+ * `finish_printf`, so the output is still written at once. If the block
+ * cannot be allocated, callers flush the buffer instead and the output
+ * leaves in several writes (see `must_write_out`).
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ * @param want Number of bytes about to be appended.
+ *
+ * @return 0 on success, -1 if the block cannot be allocated.
+ *
+ * @see finish_printf
+ * @ingroup ft_printf
+ */
+static int spill_buffer(t_pf* pf, size_t want)
+{
+	size_t new_cap;
+	char*  new_buf;
+
+	new_cap = pf->cap * 2;
+	if (new_cap < pf->len + want)
+		new_cap = pf->len + want;
+	new_buf = malloc(new_cap);
+	if (!new_buf)
+		return (-1);
+	ft_memcpy(new_buf, pf->buf, pf->len);
+	if (pf->spilled)
+		free(pf->buf);
+	pf->buf     = new_buf;
+	pf->cap     = new_cap;
+	pf->spilled = 1;
+	return (0);
 }
 
 /**
- * @brief Safely writes `len` bytes from a string to a file descriptor.
+ * @brief Tells whether a full `PF_SINK_FD` buffer must be written out
+ *        before `want` more bytes are appended.
+ *
+ * @details
+ * A held buffer is always written out. A one-shot buffer spills to the
+ * heap instead; if that fails, it is written out early, unless
+ * `must_spill` is set: then `malloc_error` is set and nothing is
+ * written. `ft_dprintf` sets it because its output is bound for the
+ * descriptor's own buffer, which may still hold bytes from earlier
+ * calls that must leave first.
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ * @param want Number of bytes about to be appended.
+ *
+ * @return 1 if the buffer must be written out, 0 if it spilled or the
+ *         call failed.
+ *
+ * @see spill_buffer
+ * @ingroup ft_printf
+ */
+static int must_write_out(t_pf* pf, size_t want)
+{
+	if (pf->hold)
+		return (1);
+	if (spill_buffer(pf, want) == 0)
+		return (0);
+	if (!pf->must_spill)
+		return (1);
+	pf->malloc_error = 1;
+	return (0);
+}
+
+/**
+ * @brief Makes room in the buffer for the next `want` bytes.
+ *
+ * @details
+ * Flushes a held `PF_SINK_FD` buffer, spills a one-shot one to the heap,
+ * or grows a `PF_SINK_ALLOC` buffer when `want` bytes do not fit. A
+ * `PF_SINK_MEM` buffer cannot make room, so the returned space may be
+ * smaller than `want`.
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ * @param want Number of bytes about to be appended.
+ *
+ * @return Number of bytes that can be stored at `pf->buf + pf->len`
+ *         (0 after an error).
+ *
+ * @ingroup ft_printf
+ */
+static size_t make_room(t_pf* pf, size_t want)
+{
+	if (pf->write_error || pf->malloc_error)
+		return (0);
+	if (want > pf->cap - pf->len)
+	{
+		if (pf->sink == PF_SINK_FD && must_write_out(pf, want))
+			flush_printf_buffer(pf);
+		else if (pf->sink == PF_SINK_ALLOC && grow_buffer(pf, want) == -1)
+			return (0);
+	}
+	if (pf->write_error || pf->malloc_error)
+		return (0);
+	return (pf->cap - pf->len);
+}
+
+/**
+ * @brief Hands the buffered output over to its sink.
+ *
+ * @details
+ * For `PF_SINK_FD`, writes the pending bytes with as few system calls as
+ * the kernel allows; after a write error they are discarded. For memory
+ * sinks, null-terminates the buffer (allocating an empty string first if
+ * a `PF_SINK_ALLOC` buffer was never used).
+ *
+ * Called whenever an fd buffer fills up, and once at the end of a call.
+ *
+ * @param pf Pointer to printf state context (`t_pf`).
+ *
+ * @ingroup ft_printf
+ */
+void flush_printf_buffer(t_pf* pf)
+{
+	if (pf->sink == PF_SINK_FD)
+	{
+		if (pf->len > 0)
+			write_through(pf, NULL, 0);
+		pf->len = 0;
+		return;
+	}
+	if (pf->sink == PF_SINK_ALLOC && !pf->buf && grow_buffer(pf, 0) == -1)
+		return;
+	if (pf->buf)
+		pf->buf[pf->len] = '\0';
+}
+
+/**
+ * @brief Appends a null-terminated string to the output.
+ *
+ * @param str Null-terminated string to write.
+ * @param pf Pointer to printf state context (`t_pf`).
+ *
+ * @see write_safely_len
+ * @ingroup ft_printf
+ */
+void write_safely(char* str, t_pf* pf)
+{
+	if (str == NULL)
+		return;
+	write_safely_len(str, ft_strlen(str), pf);
+}
+
+/**
+ * @brief Appends `len` bytes to the output.
  *
  * @details
  * Unlike `write_safely`, this function writes a fixed number of bytes
- * (useful for non-null-terminated data). Handles `EINTR` and write errors.
+ * (useful for non-null-terminated data). The bytes are copied into the
+ * buffer after making room for them. For `PF_SINK_FD`, a chunk at least
+ * as large as the whole buffer is written directly, in the same `writev`
+ * as the pending buffer, unless the call is one-shot and its buffer can
+ * spill to the heap.
  *
- * @param fd File descriptor to write to.
  * @param str Buffer containing data to write.
  * @param len Number of bytes to write.
  * @param pf Pointer to printf state context (`t_pf`).
  *
+ * @see make_room
  * @ingroup ft_printf
  */
-void write_safely_len(int fd, char* str, size_t len, t_pf* pf)
+void write_safely_len(char* str, size_t len, t_pf* pf)
 {
-	ssize_t bytes_written;
-	size_t  total_written;
+	size_t room;
 
-	if (str == NULL)
+	if (str == NULL || len == 0)
 		return;
-	total_written = 0;
-	while (total_written < len)
+	pf->total += len;
+	if (pf->sink == PF_SINK_FD && len >= pf->cap && must_write_out(pf, len))
 	{
-		bytes_written = write(fd, str + total_written, len - total_written);
-		if (bytes_written == -1)
-		{
-			if (errno == EINTR)
-				continue;
-			pf->write_error = 1;
-			return;
-		}
-		total_written += bytes_written;
+		write_through(pf, str, len);
+		return;
 	}
-	pf->total += total_written;
+	room = make_room(pf, len);
+	if (room > len)
+		room = len;
+	if (room > 0)
+		ft_memcpy(pf->buf + pf->len, str, room);
+	pf->len += room;
 }
 
 /**
- * @brief Safely writes a single character to a file descriptor.
+ * @brief Appends a single character to the output.
+ *
+ * @param c Character to write.
+ * @param pf Pointer to printf state context (`t_pf`).
+ *
+ * @ingroup ft_printf
+ */
+void write_char_safely(char c, t_pf* pf)
+{
+	pf->total++;
+	if (make_room(pf, 1) > 0)
+		pf->buf[pf->len++] = c;
+}
+
+/**
+ * @brief Appends `n` copies of a character to the output.
  *
  * @details
- * Attempts to write `c` to `fd`. If interrupted (`EINTR`), retries.
- * Updates total byte count or sets write error in `pf` on failure.
+ * The copies are set in the buffer with `ft_memset`, in as many steps
+ * as it takes to make room. For `PF_SINK_FD`, a run at least as large
+ * as the whole buffer is written with the pending buffer through
+ * `writev` from a repeated block instead, unless the call is one-shot
+ * and its buffer can spill to the heap. Either way the cost does not
+ * grow per character.
  *
- * @param fd File descriptor to write to.
- * @param c Character to write.
+ * @param c Character to repeat.
+ * @param n Number of copies.
  * @param pf Pointer to printf state context (`t_pf`).
  *
+ * @see print_padding
  * @ingroup ft_printf
  */
-void write_char_safely(int fd, char c, t_pf* pf)
+void write_repeat_safely(char c, size_t n, t_pf* pf)
 {
-	ssize_t bytes_written;
+	size_t room;
 
-	bytes_written = write(fd, &c, 1);
-	if (bytes_written == -1)
+	if (n == 0)
+		return;
+	pf->total += n;
+	if (pf->sink == PF_SINK_FD && n >= pf->cap && must_write_out(pf, n))
 	{
-		if (errno == EINTR)
-		{
-			write_char_safely(fd, c, pf);
-			return;
-		}
-		pf->write_error = 1;
+		write_repeated(pf, c, n);
 		return;
 	}
-	pf->total += bytes_written;
+	while (n > 0)
+	{
+		room = make_room(pf, n);
+		if (room == 0)
+			return;
+		if (room > n)
+			room = n;
+		ft_memset(pf->buf + pf->len, c, room);
+		pf->len += room;
+		n -= room;
+	}
 }
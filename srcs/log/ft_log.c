@@ -0,0 +1,261 @@
+/**
+ * @file ft_log.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Public operations of the asynchronous logger.
+ *
+ * @details
+ * `ft_log` formats straight into a claimed ring slot with `ft_vsnprintf`,
+ * so a message costs one compare-and-swap, the formatting itself and
+ * one store; the `write` happens later on the writer thread of
+ * `log_ring.c`. Opening, flushing and closing the logger are the only
+ * operations that allocate, wait or join.
+ *
+ * @ingroup log
+ */
+
+#include "libft.h"
+
+/**
+ * @internal
+ * @brief Returns the smallest power of two not below @p n (at least 2).
+ */
+static size_t ring_size(size_t n)
+{
+	size_t size;
+
+	size = 2;
+	while (size < n)
+		size *= 2;
+	return (size);
+}
+
+/**
+ * @brief Creates a logger and starts its writer thread.
+ *
+ * @details
+ * The ring is allocated here, once: the logger never allocates again.
+ * Slot `i` starts ready for position `i`.
+ *
+ * @param fd       Descriptor the messages are written to.
+ * @param capacity Number of slots (rounded up to a power of two, at
+ *                 least 2).
+ * @param policy   What `ft_log` does when the ring is full.
+ * @return A new logger, or NULL on failure.
+ *
+ * @see ft_log_close
+ * @ingroup log
+ */
+t_log* ft_log_open(int fd, size_t capacity, t_log_policy policy)
+{
+	t_log* log;
+	size_t i;
+
+	if (fd < 0)
+		return (NULL);
+	log = ft_calloc(1, sizeof(t_log));
+	if (!log)
+		return (NULL);
+	log->mask  = ring_size(capacity) - 1;
+	log->slots = malloc((log->mask + 1) * sizeof(t_log_slot));
+	if (!log->slots)
+	{
+		free(log);
+		return (NULL);
+	}
+	i = 0;
+	while (i <= log->mask)
+	{
+		atomic_init(&log->slots[i].seq, i);
+		i++;
+	}
+	log->fd     = fd;
+	log->policy = policy;
+	atomic_init(&log->running, 1);
+	pthread_mutex_init(&log->lock, NULL);
+	pthread_cond_init(&log->wake, NULL);
+	pthread_cond_init(&log->drained, NULL);
+	if (pthread_create(&log->thread, NULL, log_writer_main, log) != 0)
+	{
+		pthread_mutex_destroy(&log->lock);
+		pthread_cond_destroy(&log->wake);
+		pthread_cond_destroy(&log->drained);
+		free(log->slots);
+		free(log);
+		return (NULL);
+	}
+	return (log);
+}
+
+/**
+ * @brief Formats a message as text into a claimed slot.
+ *
+ * @details
+ * A message that does not fit is cut to `LOG_MSG_MAX - 1` bytes, the
+ * last one replaced by a newline.
+ *
+ * @param slot   The slot.
+ * @param format An `ft_printf` format string.
+ * @param args   Arguments matching the format.
+ * @return The length of the message in the slot.
+ *
+ * @ingroup log
+ */
+size_t log_format_slot(t_log_slot* slot, const char* format, va_list args)
+{
+	int len;
+
+	len = ft_vsnprintf(slot->data, LOG_MSG_MAX, format, args);
+	if (len < 0)
+		len = 0;
+	if ((size_t) len >= LOG_MSG_MAX)
+	{
+		len                 = LOG_MSG_MAX - 1;
+		slot->data[len - 1] = '\n';
+	}
+	slot->len    = len;
+	slot->binary = 0;
+	return (len);
+}
+
+/**
+ * @brief Formats a message into the logger's ring, with a `va_list`.
+ *
+ * @details
+ * The message is formatted in place, in the slot the writer thread will
+ * read.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string.
+ * @param args   Arguments matching the format.
+ * @return The number of bytes queued, or -1 if the message was dropped.
+ *
+ * @see log_claim_slot
+ * @see log_format_slot
+ * @see log_publish_slot
+ * @ingroup log
+ */
+int ft_vlog(t_log* log, const char* format, va_list args)
+{
+	t_log_slot* slot;
+	size_t      pos;
+	size_t      len;
+
+	if (!log || !format)
+		return (-1);
+	slot = log_claim_slot(log, &pos);
+	if (!slot)
+	{
+		atomic_fetch_add_explicit(&log->dropped, 1, memory_order_relaxed);
+		return (-1);
+	}
+	len = log_format_slot(slot, format, args);
+	log_publish_slot(log, slot, pos);
+	return (len);
+}
+
+/**
+ * @brief Formats a message into the logger's ring.
+ *
+ * @details
+ * Returns as soon as the message is queued; it reaches the descriptor
+ * when the writer thread gets to it. With `LOG_BLOCK`, a full ring makes
+ * the call wait for room.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string.
+ * @param ...    Arguments matching the format.
+ * @return The number of bytes queued, or -1 if the message was dropped.
+ *
+ * @see ft_vlog
+ * @ingroup log
+ */
+int ft_log(t_log* log, const char* format, ...)
+{
+	va_list args;
+	int     result;
+
+	va_start(args, format);
+	result = ft_vlog(log, format, args);
+	va_end(args);
+	return (result);
+}
+
+/**
+ * @brief Waits until every message queued so far has been written.
+ *
+ * @details
+ * Messages queued by other threads while waiting may or may not be
+ * included. The caller sleeps on `drained`, which the writer thread
+ * broadcasts after each batch while `flushers` is non-zero; `flushers`
+ * is raised before `tail` is read, so no batch can be missed.
+ *
+ * @param log The logger.
+ * @return 0 on success, -1 if a write has failed.
+ *
+ * @see log_drain
+ * @ingroup log
+ */
+int ft_log_flush(t_log* log)
+{
+	size_t target;
+
+	if (!log)
+		return (-1);
+	target = atomic_load(&log->head);
+	atomic_fetch_add(&log->flushers, 1);
+	log_wake_writer(log);
+	pthread_mutex_lock(&log->lock);
+	while ((ptrdiff_t) (atomic_load(&log->tail) - target) < 0)
+		pthread_cond_wait(&log->drained, &log->lock);
+	pthread_mutex_unlock(&log->lock);
+	atomic_fetch_sub(&log->flushers, 1);
+	return ((atomic_load(&log->failed)) ? -1 : 0);
+}
+
+/**
+ * @brief Returns how many messages `LOG_DROP` has discarded.
+ *
+ * @param log The logger.
+ * @return The number of dropped messages.
+ *
+ * @ingroup log
+ */
+size_t ft_log_dropped(t_log* log)
+{
+	if (!log)
+		return (0);
+	return (atomic_load(&log->dropped));
+}
+
+/**
+ * @brief Writes the pending messages, stops the writer thread and frees
+ *        the logger.
+ *
+ * @details
+ * The writer thread drains every queued message before it exits. The
+ * descriptor itself is left open.
+ *
+ * @param log The logger (NULL is ignored).
+ * @return 0 on success, -1 if a write has failed.
+ *
+ * @see ft_log_open
+ * @ingroup log
+ */
+int ft_log_close(t_log* log)
+{
+	int result;
+
+	if (!log)
+		return (0);
+	atomic_store(&log->running, 0);
+	log_wake_writer(log);
+	pthread_join(log->thread, NULL);
+	result = (atomic_load(&log->failed)) ? -1 : 0;
+	pthread_mutex_destroy(&log->lock);
+	pthread_cond_destroy(&log->wake);
+	pthread_cond_destroy(&log->drained);
+	free(log->slots);
+	free(log);
+	return (result);
+}
@@ -0,0 +1,423 @@
+/**
+ * @file log_binary.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Deferred binary logging: record arguments now, format later.
+ *
+ * @details
+ * `ft_log_binary` moves the formatting cost off the caller. It walks the
+ * format with the `ft_printf` parser only to learn the argument types,
+ * and stores in its ring slot:
+ * - a `CLOCK_REALTIME` timestamp, in nanoseconds (8 bytes)
+ * - the format pointer
+ * - every argument as raw bytes: integers widened to 64 bits, doubles,
+ *   pointers, and strings copied with their terminator after a 32-bit
+ *   length (`LOG_NULL_STR` for NULL)
+ *
+ * A format with a custom conversion (`ft_printf_register`) cannot be
+ * recorded, as the size of its arguments is unknown: such a message is
+ * formatted as text right away, like `ft_log` does.
+ *
+ * `ft_log_decode` replays the format over the record and renders each
+ * conversion with the regular `ft_printf` handlers, after a
+ * `seconds.nanoseconds` prefix. The writer thread decodes binary slots
+ * this way before writing them.
+ *
+ * @ingroup log
+ */
+
+#include "libft.h"
+#include <time.h>
+
+/**
+ * @brief Size of the record header: timestamp and format pointer.
+ */
+#define LOG_RECORD_HEADER (sizeof(uint64_t) + sizeof(const char*))
+
+/**
+ * @brief String length recorded for a NULL `%s` argument.
+ */
+#define LOG_NULL_STR 0xFFFFFFFFu
+
+/**
+ * @internal
+ * @brief Appends @p n bytes to a record, if they fit.
+ *
+ * @return 0 on success, -1 if the record is full.
+ */
+static int put_bytes(char* record, size_t* len, const void* src, size_t n)
+{
+	if (n > LOG_MSG_MAX - *len)
+		return (-1);
+	ft_memcpy(record + *len, src, n);
+	*len += n;
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Reads @p n bytes from a record, if they are there.
+ *
+ * @return 0 on success, -1 if the record ends first.
+ */
+static int get_bytes(const char* record, size_t len, size_t* pos, void* dst,
+                     size_t n)
+{
+	if (n > len - *pos)
+		return (-1);
+	ft_memcpy(dst, record + *pos, n);
+	*pos += n;
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Copies a `%s` argument into a record.
+ *
+ * @details
+ * At most the precision is copied, as that is all `%s` prints. A string
+ * that does not fit is cut to the room left.
+ *
+ * @return 0 on success, -1 if not even the length fits.
+ */
+static int put_string(char* record, size_t* len, t_fmt* fmt, const char* s)
+{
+	uint32_t n;
+	size_t   room;
+
+	if (!s)
+	{
+		n = LOG_NULL_STR;
+		return (put_bytes(record, len, &n, sizeof(n)));
+	}
+	room = LOG_MSG_MAX - *len;
+	if (room < sizeof(n) + 1)
+		return (-1);
+	room -= sizeof(n) + 1;
+	n = (fmt->precision >= 0) ? ft_strnlen(s, fmt->precision)
+	                          : ft_strnlen(s, room);
+	if (n > room)
+		n = room;
+	put_bytes(record, len, &n, sizeof(n));
+	put_bytes(record, len, s, n);
+	record[(*len)++] = '\0';
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Records the argument of one conversion.
+ *
+ * @return 0 on success, -1 if it does not fit, -2 if the conversion is
+ *         not a built-in one.
+ */
+static int put_arg(char* record, size_t* len, t_fmt* fmt, va_list* args)
+{
+	char     c;
+	uint64_t value;
+	double   real;
+	int      ch;
+
+	c = fmt->specifier;
+	if (c == 'd' || c == 'i')
+		value = fetch_signed_arg(fmt, args);
+	else if (c == 'u' || c == 'x' || c == 'X')
+		value = fetch_unsigned_arg(fmt, args);
+	else if (c == 'p')
+		value = (uintptr_t) va_arg(*args, void*);
+	else if (c == 'c')
+	{
+		ch = va_arg(*args, int);
+		return (put_bytes(record, len, &ch, sizeof(ch)));
+	}
+	else if (c == 's')
+		return (put_string(record, len, fmt, va_arg(*args, const char*)));
+	else if (c == '%')
+		return (0);
+	else if (c && ft_strchr("fFeEgGaA", c))
+	{
+		real = va_arg(*args, double);
+		return (put_bytes(record, len, &real, sizeof(real)));
+	}
+	else
+		return (-2);
+	return (put_bytes(record, len, &value, sizeof(value)));
+}
+
+/**
+ * @internal
+ * @brief Records every argument @p format consumes.
+ *
+ * @details
+ * Stops at the first argument that does not fit; the decoder stops at
+ * the same place.
+ *
+ * @return The record length, or 0 if a conversion cannot be recorded.
+ */
+static size_t put_args(char* record, size_t len, const char* format,
+                       va_list* args)
+{
+	t_fmt fmt;
+	int   status;
+
+	while (*format)
+	{
+		if (*format++ != '%')
+			continue;
+		if (*format == '\0')
+			break;
+		ft_bzero(&fmt, sizeof(t_fmt));
+		fmt.precision = -1;
+		status        = 0;
+		if (setup_format(&format, &fmt) == 0)
+			status = put_arg(record, &len, &fmt, args);
+		if (status == -2)
+			return (0);
+		if (status == -1)
+			break;
+	}
+	return (len);
+}
+
+/**
+ * @brief Records a message to be formatted later, with a `va_list`.
+ *
+ * @details
+ * The caller pays for a slot claim, a clock read and the copy of the
+ * arguments; formatting happens on the writer thread. A format with a
+ * custom conversion is formatted as text instead.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string that outlives the logger.
+ * @param args   Arguments matching the format.
+ * @return The size of the record queued, or -1 if it was dropped.
+ *
+ * @see ft_log_decode
+ * @ingroup log
+ */
+int ft_vlog_binary(t_log* log, const char* format, va_list args)
+{
+	struct timespec ts;
+	t_log_slot*     slot;
+	uint64_t        stamp;
+	va_list         copy;
+	size_t          pos;
+	size_t          len;
+
+	if (!log || !format)
+		return (-1);
+	clock_gettime(CLOCK_REALTIME, &ts);
+	slot = log_claim_slot(log, &pos);
+	if (!slot)
+	{
+		atomic_fetch_add_explicit(&log->dropped, 1, memory_order_relaxed);
+		return (-1);
+	}
+	stamp = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+	ft_memcpy(slot->data, &stamp, sizeof(stamp));
+	ft_memcpy(slot->data + sizeof(stamp), &format, sizeof(format));
+	va_copy(copy, args);
+	len = put_args(slot->data, LOG_RECORD_HEADER, format, &copy);
+	va_end(copy);
+	slot->len    = len;
+	slot->binary = 1;
+	if (len == 0)
+		len = log_format_slot(slot, format, args);
+	log_publish_slot(log, slot, pos);
+	return (len);
+}
+
+/**
+ * @brief Records a message to be formatted later by the writer thread.
+ *
+ * @param log    The logger.
+ * @param format An `ft_printf` format string that outlives the logger.
+ * @param ...    Arguments matching the format.
+ * @return The size of the record queued, or -1 if it was dropped.
+ *
+ * @see ft_vlog_binary
+ * @ingroup log
+ */
+int ft_log_binary(t_log* log, const char* format, ...)
+{
+	va_list args;
+	int     result;
+
+	va_start(args, format);
+	result = ft_vlog_binary(log, format, args);
+	va_end(args);
+	return (result);
+}
+
+/**
+ * @internal
+ * @brief Calls the `ft_printf` handler of @p fmt on the arguments given.
+ */
+static void render_arg(t_fmt* fmt, t_pf* pf, ...)
+{
+	va_list args;
+
+	va_start(args, pf);
+	get_printf_specs()[(unsigned char) fmt->specifier].handler(fmt, &args,
+	                                                           pf);
+	va_end(args);
+}
+
+/**
+ * @internal
+ * @brief Renders one conversion from its recorded argument.
+ *
+ * @details
+ * Integers were widened when recorded, so they print with the `ll`
+ * length: the narrowing of `hh` or `h` has already happened.
+ *
+ * @return 0 on success, -1 if the record ends first.
+ */
+static int render_recorded(t_fmt* fmt, const char* record, size_t len,
+                           size_t* pos, t_pf* pf)
+{
+	char     c;
+	uint64_t value;
+	double   real;
+	uint32_t n;
+	int      ch;
+
+	c = fmt->specifier;
+	if (c == '%')
+		render_arg(fmt, pf);
+	else if (c == 'c' && get_bytes(record, len, pos, &ch, sizeof(ch)) == 0)
+		render_arg(fmt, pf, ch);
+	else if (c == 's' && get_bytes(record, len, pos, &n, sizeof(n)) == 0)
+	{
+		if (n == LOG_NULL_STR)
+			render_arg(fmt, pf, (const char*) NULL);
+		else if (n < len - *pos)
+			render_arg(fmt, pf, record + *pos);
+		else
+			return (-1);
+		*pos += (n == LOG_NULL_STR) ? 0 : n + 1;
+	}
+	else if (ft_strchr("fFeEgGaA", c)
+	         && get_bytes(record, len, pos, &real, sizeof(real)) == 0)
+		render_arg(fmt, pf, real);
+	else if (ft_strchr("diuxXp", c)
+	         && get_bytes(record, len, pos, &value, sizeof(value)) == 0)
+	{
+		fmt->length = PF_LEN_LL;
+		if (c == 'p')
+			render_arg(fmt, pf, (void*) (uintptr_t) value);
+		else
+			render_arg(fmt, pf, (unsigned long long) value);
+	}
+	else
+		return (-1);
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Writes the `seconds.nanoseconds ` prefix of a record.
+ */
+static void render_stamp(uint64_t stamp, t_pf* pf)
+{
+	t_fmt fmt;
+
+	ft_bzero(&fmt, sizeof(t_fmt));
+	fmt.specifier = 'u';
+	fmt.length    = PF_LEN_LL;
+	fmt.precision = -1;
+	render_arg(&fmt, pf, (unsigned long long) (stamp / 1000000000));
+	write_char_safely('.', pf);
+	fmt.precision = 9;
+	render_arg(&fmt, pf, (unsigned long long) (stamp % 1000000000));
+	write_char_safely(' ', pf);
+}
+
+/**
+ * @brief Renders a binary record as text.
+ *
+ * @details
+ * Replays the recorded format like `ft_printf` does, taking each
+ * argument from the record instead of a `va_list`. If the record ends
+ * before the format does (its arguments did not fit in the slot), the
+ * text is cut there and ends with a newline.
+ *
+ * @param record The record, as stored by `ft_log_binary`.
+ * @param len    Its size in bytes.
+ * @param out    Destination buffer (may be NULL if @p size is 0).
+ * @param size   Size of @p out in bytes.
+ * @return The length of the full text (`snprintf` semantics), or -1 on
+ *         error.
+ *
+ * @see ft_vlog_binary
+ * @ingroup log
+ */
+int ft_log_decode(const char* record, size_t len, char* out, size_t size)
+{
+	t_pf        pf;
+	uint64_t    stamp;
+	const char* format;
+	const char* start;
+	const char* percent;
+	size_t      pos;
+
+	if (!record || len < LOG_RECORD_HEADER || (!out && size > 0))
+		return (-1);
+	ft_memcpy(&stamp, record, sizeof(stamp));
+	ft_memcpy(&format, record + sizeof(stamp), sizeof(format));
+	initialize_printf_structs(&pf);
+	pf.sink = PF_SINK_MEM;
+	pf.buf  = (size > 0) ? out : NULL;
+	pf.cap  = (size > 0) ? size - 1 : 0;
+	pos     = LOG_RECORD_HEADER;
+	render_stamp(stamp, &pf);
+	while (*format)
+	{
+		start = format;
+		while (*format && *format != '%')
+			format++;
+		write_safely_len((char*) start, format - start, &pf);
+		percent = format;
+		if (*format == '\0' || *++format == '\0')
+			break;
+		ft_bzero(&pf.fmt, sizeof(t_fmt));
+		pf.fmt.precision = -1;
+		if (setup_format(&format, &pf.fmt) == -1)
+			write_safely_len((char*) percent, format - percent, &pf);
+		else if (render_recorded(&pf.fmt, record, len, &pos, &pf) == -1)
+		{
+			write_char_safely('\n', &pf);
+			break;
+		}
+	}
+	return (finish_printf(&pf));
+}
+
+/**
+ * @brief Renders the binary record of a slot for the writer thread.
+ *
+ * @details
+ * Text longer than `LOG_TEXT_MAX - 1` bytes is cut, its last byte
+ * replaced by a newline.
+ *
+ * @param slot The slot.
+ * @param text Destination of `LOG_TEXT_MAX` bytes.
+ * @return The length of the text.
+ *
+ * @see ft_log_decode
+ * @ingroup log
+ */
+size_t log_render_slot(t_log_slot* slot, char* text)
+{
+	int len;
+
+	len = ft_log_decode(slot->data, slot->len, text, LOG_TEXT_MAX);
+	if (len < 0)
+		return (0);
+	if (len >= LOG_TEXT_MAX)
+	{
+		len           = LOG_TEXT_MAX - 1;
+		text[len - 1] = '\n';
+	}
+	return (len);
+}
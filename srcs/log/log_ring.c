@@ -0,0 +1,276 @@
+/**
+ * @file log_ring.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Lock-free message ring and writer thread of the logger.
+ *
+ * @details
+ * The ring is a bounded multi-producer queue in the style of Vyukov:
+ * every slot carries a sequence number saying which position it is
+ * ready for, so a producer claims a slot with one compare-and-swap on
+ * `head` and publishes it with one release store, without any lock.
+ *
+ * The single writer thread is the only consumer. It collects up to
+ * `LOG_BATCH` consecutive published slots, renders the binary ones to
+ * text, writes them with one `writev`, then hands the slots back to the
+ * producers for their next lap. With nothing to write, it sleeps on a
+ * condition variable until a producer or `ft_log_close` signals it; they
+ * do so only when it is asleep, so an idle logger costs no wake-ups.
+ * Threads waiting in `ft_log_flush` are woken after each batch.
+ *
+ * @ingroup log
+ */
+
+#include "libft.h"
+#include <sched.h>
+#include <sys/uio.h>
+
+/**
+ * @brief Claims the next free slot of the ring.
+ *
+ * @details
+ * Retries while other producers win the race for `head`. With the
+ * `LOG_BLOCK` policy a full ring wakes the writer thread and yields
+ * until a slot frees up; with `LOG_DROP` it gives up.
+ *
+ * @param log The logger.
+ * @param pos Receives the ring position of the claimed slot.
+ * @return The slot, or NULL if the ring is full under `LOG_DROP`.
+ *
+ * @see log_publish_slot
+ * @ingroup log
+ */
+t_log_slot* log_claim_slot(t_log* log, size_t* pos)
+{
+	t_log_slot* slot;
+	size_t      seq;
+
+	*pos = atomic_load_explicit(&log->head, memory_order_relaxed);
+	while (1)
+	{
+		slot = &log->slots[*pos & log->mask];
+		seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+		if (seq == *pos)
+		{
+			if (atomic_compare_exchange_weak_explicit(&log->head, pos,
+			                                          *pos + 1,
+			                                          memory_order_relaxed,
+			                                          memory_order_relaxed))
+				return (slot);
+		}
+		else if ((ptrdiff_t) (seq - *pos) < 0)
+		{
+			if (log->policy == LOG_DROP)
+				return (NULL);
+			log_wake_writer(log);
+			sched_yield();
+			*pos = atomic_load_explicit(&log->head, memory_order_relaxed);
+		}
+		else
+			*pos = atomic_load_explicit(&log->head, memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Makes a filled slot visible to the writer thread.
+ *
+ * @details
+ * Both the store and the check of `sleeping` are sequentially
+ * consistent, pairing with `wait_for_messages`: either the writer sees
+ * the message before it sleeps, or this call sees it asleep.
+ *
+ * @param log  The logger.
+ * @param slot The slot returned by `log_claim_slot`.
+ * @param pos  Its ring position.
+ *
+ * @ingroup log
+ */
+void log_publish_slot(t_log* log, t_log_slot* slot, size_t pos)
+{
+	atomic_store(&slot->seq, pos + 1);
+	if (atomic_load(&log->sleeping))
+		log_wake_writer(log);
+}
+
+/**
+ * @brief Wakes the writer thread if it is asleep.
+ *
+ * @details
+ * Only the caller that clears `sleeping` signals, so a burst of
+ * messages costs a single wake-up. The signal is sent under `lock`, so
+ * it cannot fall between the writer's last check and its wait.
+ *
+ * @param log The logger.
+ *
+ * @ingroup log
+ */
+void log_wake_writer(t_log* log)
+{
+	if (atomic_exchange(&log->sleeping, 0))
+	{
+		pthread_mutex_lock(&log->lock);
+		pthread_cond_signal(&log->wake);
+		pthread_mutex_unlock(&log->lock);
+	}
+}
+
+/**
+ * @internal
+ * @brief Writes a batch of messages, resuming after partial writes.
+ *
+ * @param log   The logger (`failed` is set on error).
+ * @param iov   The messages.
+ * @param count Number of messages.
+ */
+static void write_batch(t_log* log, struct iovec* iov, int count)
+{
+	ssize_t written;
+
+	while (count > 0)
+	{
+		written = writev(log->fd, iov, count);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written < 0)
+		{
+			atomic_store(&log->failed, 1);
+			return;
+		}
+		while (count > 0 && (size_t) written >= iov->iov_len)
+		{
+			written -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0)
+		{
+			iov->iov_base = (char*) iov->iov_base + written;
+			iov->iov_len -= written;
+		}
+	}
+}
+
+/**
+ * @brief Writes the next batch of published messages.
+ *
+ * @details
+ * Stops at the first slot not yet published, so messages are written
+ * in the order their slots were claimed. Binary records are rendered
+ * into a stack buffer first. The slots are released to the
+ * producers for the next lap of the ring once the batch is written,
+ * then threads waiting in `ft_log_flush` are woken. `tail` is stored
+ * and `flushers` read sequentially consistently, pairing with
+ * `ft_log_flush`: either the flusher sees the new `tail`, or this call
+ * sees the flusher and broadcasts.
+ *
+ * @param log The logger.
+ * @return The number of messages written.
+ *
+ * @ingroup log
+ */
+size_t log_drain(t_log* log)
+{
+	struct iovec iov[LOG_BATCH];
+	char         text[LOG_BATCH][LOG_TEXT_MAX];
+	t_log_slot*  slot;
+	size_t       tail;
+	size_t       count;
+	size_t       i;
+
+	tail  = atomic_load_explicit(&log->tail, memory_order_relaxed);
+	count = 0;
+	while (count < LOG_BATCH)
+	{
+		slot = &log->slots[(tail + count) & log->mask];
+		if (atomic_load_explicit(&slot->seq, memory_order_acquire)
+		    != tail + count + 1)
+			break;
+		iov[count].iov_base = slot->data;
+		iov[count].iov_len  = slot->len;
+		if (slot->binary)
+		{
+			iov[count].iov_base = text[count];
+			iov[count].iov_len  = log_render_slot(slot, text[count]);
+		}
+		count++;
+	}
+	if (count == 0)
+		return (0);
+	write_batch(log, iov, count);
+	i = 0;
+	while (i < count)
+	{
+		slot = &log->slots[(tail + i) & log->mask];
+		atomic_store_explicit(&slot->seq, tail + i + log->mask + 1,
+		                      memory_order_release);
+		i++;
+	}
+	atomic_store(&log->tail, tail + count);
+	if (atomic_load(&log->flushers) > 0)
+	{
+		pthread_mutex_lock(&log->lock);
+		pthread_cond_broadcast(&log->drained);
+		pthread_mutex_unlock(&log->lock);
+	}
+	return (count);
+}
+
+/**
+ * @internal
+ * @brief Puts the writer thread to sleep until it is woken.
+ *
+ * @details
+ * `sleeping` is raised before the ring and `running` are checked a last
+ * time, so a message published or an `ft_log_close` in between is
+ * either seen here or clears `sleeping` and signals under `lock`. No
+ * timeout is needed: the thread only wakes when there is work.
+ *
+ * @param log The logger.
+ */
+static void wait_for_messages(t_log* log)
+{
+	size_t tail;
+
+	atomic_store(&log->sleeping, 1);
+	tail = atomic_load_explicit(&log->tail, memory_order_relaxed);
+	if (atomic_load(&log->slots[tail & log->mask].seq) == tail + 1 ||
+	    !atomic_load(&log->running))
+	{
+		atomic_store(&log->sleeping, 0);
+		return;
+	}
+	pthread_mutex_lock(&log->lock);
+	while (atomic_load(&log->sleeping))
+		pthread_cond_wait(&log->wake, &log->lock);
+	pthread_mutex_unlock(&log->lock);
+	atomic_store(&log->sleeping, 0);
+}
+
+/**
+ * @brief Body of the writer thread.
+ *
+ * @details
+ * Drains the ring until `ft_log_close` clears `running` and every
+ * claimed slot has been written.
+ *
+ * @param arg The logger.
+ * @return NULL.
+ *
+ * @see log_drain
+ * @ingroup log
+ */
+void* log_writer_main(void* arg)
+{
+	t_log* log;
+
+	log = arg;
+	while (1)
+	{
+		if (log_drain(log) > 0)
+			continue;
+		if (!atomic_load(&log->running) &&
+		    atomic_load(&log->tail) == atomic_load(&log->head))
+			return (NULL);
+		wait_for_messages(log);
+	}
+}
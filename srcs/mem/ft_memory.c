@@ -17,6 +17,10 @@
 
 #include "libft.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 /**
  * @brief Sets a block of memory to zero.
  *
@@ -77,12 +81,88 @@ void* ft_memset(void* s, int c, size_t n)
 	return (s);
 }
 
+#ifdef __SSE2__
+
+/**
+ * @internal
+ * @brief Scans aligned 16-byte blocks for a byte.
+ *
+ * @param p Aligned pointer, updated past the blocks without a match.
+ * @param n Bytes left, updated likewise; whole blocks only are read.
+ * @param c The byte.
+ * @return The matching byte, or NULL if fewer than 16 bytes are left.
+ */
+static const unsigned char* memchr_blocks(const unsigned char** p,
+                                          size_t* n, unsigned char c)
+{
+	const __m128i needle = _mm_set1_epi8((char) c);
+	int           mask;
+
+	while (*n >= 16)
+	{
+		mask = _mm_movemask_epi8(
+		    _mm_cmpeq_epi8(_mm_load_si128((const __m128i*) *p), needle));
+		if (mask)
+			return (*p + __builtin_ctz(mask));
+		*p += 16;
+		*n -= 16;
+	}
+	return (NULL);
+}
+
+#define MEMCHR_BLOCK 16
+
+#else
+
+/**
+ * @internal
+ * @brief Scans aligned 8-byte words for a byte.
+ *
+ * @details
+ * XOR with the byte repeated turns matches into zero bytes, which the
+ * classic `(w - 0x01..) & ~w & 0x80..` test finds in the whole word at
+ * once. The word holding a match is then searched byte by byte.
+ *
+ * @param p Aligned pointer, updated past the words without a match.
+ * @param n Bytes left, updated likewise; whole words only are read.
+ * @param c The byte.
+ * @return The matching byte, or NULL if fewer than 8 bytes are left.
+ */
+static const unsigned char* memchr_blocks(const unsigned char** p,
+                                          size_t* n, unsigned char c)
+{
+	uint64_t needle;
+	uint64_t w;
+
+	needle = 0x0101010101010101ULL * c;
+	while (*n >= 8)
+	{
+		w = *(const uint64_t*) *p ^ needle;
+		if ((w - 0x0101010101010101ULL) & ~w & 0x8080808080808080ULL)
+		{
+			while (**p != c)
+				(*p)++;
+			return (*p);
+		}
+		*p += 8;
+		*n -= 8;
+	}
+	return (NULL);
+}
+
+#define MEMCHR_BLOCK 8
+
+#endif
+
 /**
  * @brief Scans memory for a specific byte.
  *
  * @details
  * Searches the first @p n bytes of the memory area pointed to by @p s
- * for the first occurrence of the byte @p c.
+ * for the first occurrence of the byte @p c. After a byte-wise prologue
+ * up to the first aligned address, whole blocks are compared at once:
+ * 16 bytes with SSE2 where available, 8 bytes with word arithmetic
+ * elsewhere. No byte past @p n is ever read.
  *
  * @param s Pointer to the memory block to scan.
  * @param c Byte to search for.
@@ -94,15 +174,25 @@ void* ft_memset(void* s, int c, size_t n)
 void* ft_memchr(const void* s, int c, size_t n)
 {
 	const unsigned char* ptr;
-	size_t               i;
+	const unsigned char* match;
 
 	ptr = (const unsigned char*) s;
-	i   = 0;
-	while (i < n)
+	while (n > 0 && ((uintptr_t) ptr & (MEMCHR_BLOCK - 1)))
 	{
-		if (ptr[i] == (unsigned char) c)
-			return ((void*) (ptr + i));
-		i++;
+		if (*ptr == (unsigned char) c)
+			return ((void*) ptr);
+		ptr++;
+		n--;
+	}
+	match = memchr_blocks(&ptr, &n, (unsigned char) c);
+	if (match)
+		return ((void*) match);
+	while (n > 0)
+	{
+		if (*ptr == (unsigned char) c)
+			return ((void*) ptr);
+		ptr++;
+		n--;
 	}
 	return (NULL);
 }
@@ -291,3 +381,35 @@ void* ft_realloc(void* ptr, size_t old_size, size_t new_size)
 	free(ptr);
 	return (new_ptr);
 }
+
+/**
+ * @brief Allocates a copy of a memory block.
+ *
+ * @details
+ * Allocates @p n bytes and copies @p n bytes from @p src into them. Unlike
+ * `ft_strdup`, the data may contain any byte value and is not terminated.
+ *
+ * @param src Pointer to the bytes to copy.
+ * @param n Number of bytes to copy.
+ * @return Pointer to the new block, or NULL if @p src is NULL or the
+ * allocation fails. A zero-length copy returns a valid one-byte block.
+ *
+ * @note The caller is responsible for freeing the returned block.
+ *
+ * @see ft_strdup_len
+ * @see ft_memcpy
+ * @ingroup memory_utils
+ */
+void* ft_memdup(const void* src, size_t n)
+{
+	void* copy;
+
+	if (!src)
+		return (NULL);
+	copy = malloc((n) ? n : 1);
+	if (!copy)
+		return (NULL);
+	if (n > 0)
+		ft_memcpy(copy, src, n);
+	return (copy);
+}
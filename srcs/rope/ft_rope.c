@@ -0,0 +1,331 @@
+/**
+ * @file ft_rope.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Public rope operations built on node join and split.
+ *
+ * @details
+ * Every edit is expressed with the two primitives of `ft_rope_node.c`:
+ * - insert: split at the index, then join left + new text + right
+ * - delete: split twice and join the outer parts
+ * - concat: join the two roots
+ *
+ * The handle keeps its own reference to the old root while the new one
+ * is built, so when an allocation fails the rope is left as it was.
+ *
+ * @ingroup rope
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Creates a rope holding a copy of a string.
+ *
+ * @details
+ * Long strings are cut into `ROPE_LEAF_MAX` chunks arranged in a
+ * balanced tree.
+ *
+ * @param s The initial content (NULL creates an empty rope).
+ * @return A new rope, or NULL on allocation failure.
+ *
+ * @see ft_rope_free
+ * @ingroup rope
+ */
+t_rope* ft_rope_new(const char* s)
+{
+	t_rope* rope;
+
+	rope = malloc(sizeof(t_rope));
+	if (!rope)
+		return (NULL);
+	rope->root = NULL;
+	if (s && rope_node_build(s, ft_strlen(s), &rope->root) < 0)
+	{
+		free(rope);
+		return (NULL);
+	}
+	return (rope);
+}
+
+/**
+ * @brief Frees a rope.
+ *
+ * @details
+ * Nodes still shared with another rope (after `ft_rope_concat` or
+ * `ft_rope_split`) stay alive for that rope.
+ *
+ * @param rope The rope to free (NULL is ignored).
+ *
+ * @ingroup rope
+ */
+void ft_rope_free(t_rope* rope)
+{
+	if (!rope)
+		return;
+	rope_node_release(rope->root);
+	free(rope);
+}
+
+/**
+ * @brief Returns the number of bytes in a rope.
+ *
+ * @param rope The rope.
+ * @return Its length in O(1), or 0 if @p rope is NULL.
+ *
+ * @ingroup rope
+ */
+size_t ft_rope_len(const t_rope* rope)
+{
+	if (!rope || !rope->root)
+		return (0);
+	return (rope->root->len);
+}
+
+/**
+ * @brief Returns the byte at a given index.
+ *
+ * @details
+ * Descends from the root using the cached subtree lengths, in O(log n).
+ *
+ * @param rope  The rope.
+ * @param index Byte index.
+ * @return The byte, or `\0` if @p index is out of range.
+ *
+ * @ingroup rope
+ */
+char ft_rope_char_at(const t_rope* rope, size_t index)
+{
+	const t_rope_node* n;
+
+	if (index >= ft_rope_len(rope))
+		return ('\0');
+	n = rope->root;
+	while (n->left)
+	{
+		if (index < n->left->len)
+			n = n->left;
+		else
+		{
+			index -= n->left->len;
+			n = n->right;
+		}
+	}
+	return (n->data[index]);
+}
+
+/**
+ * @brief Inserts a string at a given index.
+ *
+ * @details
+ * Splits the rope at @p index and joins the two halves around a tree
+ * built from @p s, in O(log n + strlen(s)).
+ *
+ * @param rope  The rope to edit.
+ * @param index Insertion point (clamped to the rope length).
+ * @param s     The string to insert (NULL or empty is a no-op).
+ * @return 0 on success, -1 on allocation failure (rope unchanged).
+ *
+ * @see rope_node_split
+ * @see rope_node_join
+ * @ingroup rope
+ */
+int ft_rope_insert(t_rope* rope, size_t index, const char* s)
+{
+	t_rope_node* piece;
+	t_rope_node* left;
+	t_rope_node* right;
+
+	if (!rope)
+		return (-1);
+	if (!s || !*s)
+		return (0);
+	if (rope_node_build(s, ft_strlen(s), &piece) < 0)
+		return (-1);
+	if (rope_node_split(rope_node_retain(rope->root), index, &left, &right) <
+	    0)
+		return (rope_node_release(piece), -1);
+	if (rope_node_join(left, piece, &left) < 0)
+		return (rope_node_release(right), -1);
+	if (rope_node_join(left, right, &left) < 0)
+		return (-1);
+	rope_node_release(rope->root);
+	rope->root = left;
+	return (0);
+}
+
+/**
+ * @brief Removes a range of bytes.
+ *
+ * @details
+ * Splits around the range and joins the outer parts, in O(log n).
+ *
+ * @param rope  The rope to edit.
+ * @param index First byte to remove.
+ * @param len   Number of bytes to remove (clamped to the rope end).
+ * @return 0 on success, -1 on allocation failure (rope unchanged).
+ *
+ * @ingroup rope
+ */
+int ft_rope_delete(t_rope* rope, size_t index, size_t len)
+{
+	t_rope_node* left;
+	t_rope_node* mid;
+	t_rope_node* right;
+	size_t       total;
+
+	total = ft_rope_len(rope);
+	if (!rope || index >= total || len == 0)
+		return ((rope) ? 0 : -1);
+	if (len > total - index)
+		len = total - index;
+	if (rope_node_split(rope_node_retain(rope->root), index, &left, &mid) < 0)
+		return (-1);
+	if (rope_node_split(mid, len, &mid, &right) < 0)
+		return (rope_node_release(left), -1);
+	rope_node_release(mid);
+	if (rope_node_join(left, right, &left) < 0)
+		return (-1);
+	rope_node_release(rope->root);
+	rope->root = left;
+	return (0);
+}
+
+/**
+ * @brief Appends the content of one rope to another.
+ *
+ * @details
+ * The two trees are joined in O(log n) without copying any text; the
+ * nodes of @p src are shared, so @p src stays valid and unchanged. A rope
+ * may be appended to itself.
+ *
+ * @param dst The rope to append to.
+ * @param src The rope to append.
+ * @return 0 on success, -1 on allocation failure (@p dst unchanged).
+ *
+ * @ingroup rope
+ */
+int ft_rope_concat(t_rope* dst, const t_rope* src)
+{
+	t_rope_node* joined;
+
+	if (!dst)
+		return (-1);
+	if (!src || !src->root)
+		return (0);
+	if (rope_node_join(rope_node_retain(dst->root),
+	                   rope_node_retain(src->root), &joined) < 0)
+		return (-1);
+	rope_node_release(dst->root);
+	dst->root = joined;
+	return (0);
+}
+
+/**
+ * @brief Splits a rope in two at a given index.
+ *
+ * @details
+ * After the call @p rope holds the bytes before @p index and the
+ * returned rope holds the rest. Runs in O(log n).
+ *
+ * @param rope  The rope to split.
+ * @param index Split point (clamped to the rope length).
+ * @return A new rope with the bytes from @p index on, or NULL on
+ *         allocation failure (@p rope unchanged).
+ *
+ * @ingroup rope
+ */
+t_rope* ft_rope_split(t_rope* rope, size_t index)
+{
+	t_rope*      tail;
+	t_rope_node* left;
+
+	if (!rope)
+		return (NULL);
+	tail = ft_rope_new(NULL);
+	if (!tail)
+		return (NULL);
+	if (rope_node_split(rope_node_retain(rope->root), index, &left,
+	                    &tail->root) < 0)
+	{
+		free(tail);
+		return (NULL);
+	}
+	rope_node_release(rope->root);
+	rope->root = left;
+	return (tail);
+}
+
+/**
+ * @internal
+ * @brief In-order walk calling @p f on each leaf.
+ */
+static void iter_node(const t_rope_node* n,
+                      void (*f)(const char*, size_t, void*), void* ctx)
+{
+	while (n && n->left)
+	{
+		iter_node(n->left, f, ctx);
+		n = n->right;
+	}
+	if (n)
+		f(n->data, n->len, ctx);
+}
+
+/**
+ * @brief Calls a function on each leaf chunk, in order.
+ *
+ * @details
+ * Chunks are passed as pointer and length into the rope's own storage;
+ * they are not null-terminated and must not be modified.
+ *
+ * @param rope The rope to walk.
+ * @param f    Called with each chunk, its length and @p ctx.
+ * @param ctx  User pointer passed through to @p f.
+ *
+ * @ingroup rope
+ */
+void ft_rope_iter(const t_rope* rope, void (*f)(const char*, size_t, void*),
+                  void* ctx)
+{
+	if (!rope || !f)
+		return;
+	iter_node(rope->root, f, ctx);
+}
+
+/**
+ * @internal
+ * @brief `ft_rope_iter` callback appending a chunk to a flat buffer.
+ */
+static void copy_chunk(const char* chunk, size_t len, void* ctx)
+{
+	char** cursor;
+
+	cursor = (char**) ctx;
+	ft_memcpy(*cursor, chunk, len);
+	*cursor += len;
+}
+
+/**
+ * @brief Copies a rope into a newly allocated contiguous string.
+ *
+ * @param rope The rope to flatten.
+ * @return A null-terminated string, or NULL on allocation failure.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ *
+ * @see ft_rope_iter
+ * @ingroup rope
+ */
+char* ft_rope_flatten(const t_rope* rope)
+{
+	char* str;
+	char* cursor;
+
+	str = malloc(ft_rope_len(rope) + 1);
+	if (!str)
+		return (NULL);
+	cursor = str;
+	ft_rope_iter(rope, copy_chunk, &cursor);
+	*cursor = '\0';
+	return (str);
+}
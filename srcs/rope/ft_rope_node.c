@@ -0,0 +1,374 @@
+/**
+ * @file ft_rope_node.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Node-level operations of the rope: join, split and build.
+ *
+ * @details
+ * Every function here takes ownership of the node references it is given
+ * and returns owned references. On allocation failure it releases what it
+ * was given and returns -1. Because nodes are never modified after
+ * creation, the caller can keep its own reference to the input tree and
+ * still have it intact if the operation fails.
+ *
+ * Balancing follows the AVL join algorithm: joining two trees of very
+ * different heights descends the spine of the taller one and rebalances
+ * on the way back up, which keeps every operation O(log n).
+ *
+ * @ingroup rope
+ */
+
+#include "libft.h"
+
+/**
+ * @internal
+ * @brief Height of a subtree (0 for an empty tree).
+ */
+static int node_height(const t_rope_node* n)
+{
+	if (!n)
+		return (0);
+	return (n->height);
+}
+
+/**
+ * @brief Takes an additional reference to a node.
+ *
+ * @details
+ * The count only needs to be atomic: the caller already owns a
+ * reference, so no ordering is required.
+ *
+ * @param n The node (may be NULL).
+ * @return @p n.
+ *
+ * @ingroup rope
+ */
+t_rope_node* rope_node_retain(t_rope_node* n)
+{
+	if (n)
+		atomic_fetch_add_explicit(&n->refs, 1, memory_order_relaxed);
+	return (n);
+}
+
+/**
+ * @brief Drops a reference to a node, freeing it when unused.
+ *
+ * @details
+ * The decrement is acquire-release, so the thread that frees the node
+ * sees every use other threads made of it before their release.
+ *
+ * @param n The node (may be NULL).
+ *
+ * @ingroup rope
+ */
+void rope_node_release(t_rope_node* n)
+{
+	if (!n || atomic_fetch_sub_explicit(&n->refs, 1, memory_order_acq_rel) > 1)
+		return;
+	rope_node_release(n->left);
+	rope_node_release(n->right);
+	free(n);
+}
+
+/**
+ * @internal
+ * @brief Allocates an uninitialized leaf of @p len bytes.
+ */
+static t_rope_node* leaf_alloc(size_t len)
+{
+	t_rope_node* leaf;
+
+	leaf = malloc(sizeof(t_rope_node) + len);
+	if (!leaf)
+		return (NULL);
+	leaf->left   = NULL;
+	leaf->right  = NULL;
+	leaf->len    = len;
+	leaf->height = 1;
+	atomic_init(&leaf->refs, 1);
+	return (leaf);
+}
+
+/**
+ * @brief Allocates a leaf holding a copy of @p len bytes of @p s.
+ *
+ * @param s   Source bytes.
+ * @param len Number of bytes (at most `ROPE_LEAF_MAX`).
+ * @return The new leaf, or NULL on allocation failure.
+ *
+ * @ingroup rope
+ */
+t_rope_node* rope_leaf_new(const char* s, size_t len)
+{
+	t_rope_node* leaf;
+
+	leaf = leaf_alloc(len);
+	if (leaf)
+		ft_memcpy(leaf->data, s, len);
+	return (leaf);
+}
+
+/**
+ * @internal
+ * @brief Creates an internal node over two non-empty subtrees.
+ */
+static int make_node(t_rope_node* l, t_rope_node* r, t_rope_node** out)
+{
+	t_rope_node* n;
+
+	n = malloc(sizeof(t_rope_node));
+	if (!n)
+	{
+		rope_node_release(l);
+		rope_node_release(r);
+		return (-1);
+	}
+	n->left   = l;
+	n->right  = r;
+	n->len    = l->len + r->len;
+	n->height = 1 + ((l->height > r->height) ? l->height : r->height);
+	atomic_init(&n->refs, 1);
+	*out = n;
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Joins two trees whose heights differ by at most two.
+ *
+ * @details
+ * Applies the single or double AVL rotation needed when the heights
+ * differ by two. Rotations build new nodes and share the grandchildren.
+ */
+static int make_balanced(t_rope_node* l, t_rope_node* r, t_rope_node** out)
+{
+	t_rope_node* a;
+	t_rope_node* b;
+	t_rope_node* c;
+	t_rope_node* t;
+
+	if (node_height(l) > node_height(r) + 1)
+	{
+		if (node_height(l->left) >= node_height(l->right))
+		{
+			a = rope_node_retain(l->left);
+			b = rope_node_retain(l->right);
+			rope_node_release(l);
+			if (make_node(b, r, &t) < 0)
+				return (rope_node_release(a), -1);
+			return (make_node(a, t, out));
+		}
+		a = rope_node_retain(l->left);
+		b = rope_node_retain(l->right->left);
+		c = rope_node_retain(l->right->right);
+		rope_node_release(l);
+		if (make_node(a, b, &t) < 0)
+			return (rope_node_release(c), rope_node_release(r), -1);
+		if (make_node(c, r, &a) < 0)
+			return (rope_node_release(t), -1);
+		return (make_node(t, a, out));
+	}
+	if (node_height(r) > node_height(l) + 1)
+	{
+		if (node_height(r->right) >= node_height(r->left))
+		{
+			b = rope_node_retain(r->left);
+			c = rope_node_retain(r->right);
+			rope_node_release(r);
+			if (make_node(l, b, &t) < 0)
+				return (rope_node_release(c), -1);
+			return (make_node(t, c, out));
+		}
+		a = rope_node_retain(r->left->left);
+		b = rope_node_retain(r->left->right);
+		c = rope_node_retain(r->right);
+		rope_node_release(r);
+		if (make_node(l, a, &t) < 0)
+			return (rope_node_release(b), rope_node_release(c), -1);
+		if (make_node(b, c, &a) < 0)
+			return (rope_node_release(t), -1);
+		return (make_node(t, a, out));
+	}
+	return (make_node(l, r, out));
+}
+
+/**
+ * @internal
+ * @brief Replaces two small leaves by one leaf holding both.
+ *
+ * @details
+ * Keeps repeated small inserts from degrading the rope into a tree of
+ * one-byte leaves.
+ */
+static int merge_leaves(t_rope_node* l, t_rope_node* r, t_rope_node** out)
+{
+	t_rope_node* leaf;
+
+	leaf = leaf_alloc(l->len + r->len);
+	if (leaf)
+	{
+		ft_memcpy(leaf->data, l->data, l->len);
+		ft_memcpy(leaf->data + l->len, r->data, r->len);
+	}
+	rope_node_release(l);
+	rope_node_release(r);
+	if (!leaf)
+		return (-1);
+	*out = leaf;
+	return (0);
+}
+
+/**
+ * @brief Concatenates two trees into a balanced tree.
+ *
+ * @details
+ * If the heights are close, a single node joins them. Otherwise the
+ * shorter tree is joined into the facing spine of the taller one and the
+ * result is rebalanced on the way up. Either input may be NULL (empty).
+ *
+ * @param l   Left tree (ownership is taken).
+ * @param r   Right tree (ownership is taken).
+ * @param out Receives the joined tree.
+ * @return 0 on success, -1 on allocation failure.
+ *
+ * @ingroup rope
+ */
+int rope_node_join(t_rope_node* l, t_rope_node* r, t_rope_node** out)
+{
+	t_rope_node* keep;
+	t_rope_node* t;
+
+	if (!l || !r)
+	{
+		*out = (l) ? l : r;
+		return (0);
+	}
+	if (!l->left && !r->left && l->len + r->len <= ROPE_LEAF_MAX)
+		return (merge_leaves(l, r, out));
+	if (l->height > r->height + 1)
+	{
+		keep = rope_node_retain(l->left);
+		t    = rope_node_retain(l->right);
+		rope_node_release(l);
+		if (rope_node_join(t, r, &t) < 0)
+			return (rope_node_release(keep), -1);
+		return (make_balanced(keep, t, out));
+	}
+	if (r->height > l->height + 1)
+	{
+		keep = rope_node_retain(r->right);
+		t    = rope_node_retain(r->left);
+		rope_node_release(r);
+		if (rope_node_join(l, t, &t) < 0)
+			return (rope_node_release(keep), -1);
+		return (make_balanced(t, keep, out));
+	}
+	return (make_node(l, r, out));
+}
+
+/**
+ * @internal
+ * @brief Splits a leaf into two new leaves at @p index.
+ */
+static int split_leaf(t_rope_node* n, size_t index, t_rope_node** left,
+                      t_rope_node** right)
+{
+	*left  = rope_leaf_new(n->data, index);
+	*right = rope_leaf_new(n->data + index, n->len - index);
+	rope_node_release(n);
+	if (*left && *right)
+		return (0);
+	rope_node_release(*left);
+	rope_node_release(*right);
+	*left  = NULL;
+	*right = NULL;
+	return (-1);
+}
+
+/**
+ * @brief Splits a tree into the bytes before and from @p index.
+ *
+ * @details
+ * Descends to the leaf containing @p index, then re-joins the subtrees
+ * left and right of the path. Only the nodes on the path are rebuilt.
+ *
+ * @param n     Tree to split (ownership is taken).
+ * @param index Split point.
+ * @param left  Receives the tree of bytes `[0, index)`.
+ * @param right Receives the tree of bytes `[index, len)`.
+ * @return 0 on success, -1 on allocation failure.
+ *
+ * @ingroup rope
+ */
+int rope_node_split(t_rope_node* n, size_t index, t_rope_node** left,
+                    t_rope_node** right)
+{
+	t_rope_node* l;
+	t_rope_node* r;
+	t_rope_node* mid;
+
+	*left  = NULL;
+	*right = NULL;
+	if (!n || index == 0 || index >= n->len)
+	{
+		if (n && index == 0)
+			*right = n;
+		else
+			*left = n;
+		return (0);
+	}
+	if (!n->left)
+		return (split_leaf(n, index, left, right));
+	l = rope_node_retain(n->left);
+	r = rope_node_retain(n->right);
+	rope_node_release(n);
+	if (index <= l->len)
+	{
+		if (rope_node_split(l, index, left, &mid) < 0)
+			return (rope_node_release(r), -1);
+		if (rope_node_join(mid, r, right) < 0)
+			return (rope_node_release(*left), *left = NULL, -1);
+		return (0);
+	}
+	if (rope_node_split(r, index - l->len, &mid, right) < 0)
+		return (rope_node_release(l), -1);
+	if (rope_node_join(l, mid, left) < 0)
+		return (rope_node_release(*right), *right = NULL, -1);
+	return (0);
+}
+
+/**
+ * @brief Builds a balanced tree holding a copy of @p len bytes of @p s.
+ *
+ * @details
+ * Cuts the input into `ROPE_LEAF_MAX` chunks and pairs them up by
+ * halving, so the result is perfectly balanced.
+ *
+ * @param s   Source bytes.
+ * @param len Number of bytes.
+ * @param out Receives the tree (NULL if @p len is 0).
+ * @return 0 on success, -1 on allocation failure.
+ *
+ * @ingroup rope
+ */
+int rope_node_build(const char* s, size_t len, t_rope_node** out)
+{
+	t_rope_node* l;
+	t_rope_node* r;
+	size_t       half;
+
+	*out = NULL;
+	if (len == 0)
+		return (0);
+	if (len <= ROPE_LEAF_MAX)
+	{
+		*out = rope_leaf_new(s, len);
+		return ((*out) ? 0 : -1);
+	}
+	half = ((len / ROPE_LEAF_MAX + 1) / 2) * ROPE_LEAF_MAX;
+	if (rope_node_build(s, half, &l) < 0)
+		return (-1);
+	if (rope_node_build(s + half, len - half, &r) < 0)
+		return (rope_node_release(l), -1);
+	return (make_node(l, r, out));
+}
@@ -0,0 +1,334 @@
+/**
+ * @file ft_strcase.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Bulk ASCII case conversion and case-insensitive comparison.
+ *
+ * @details
+ * This file implements whole-buffer variants of `ft_toupper` /
+ * `ft_tolower` and the case-insensitive comparisons `ft_strcasecmp` /
+ * `ft_strncasecmp`. Instead of one call per character, the strings are
+ * processed 16 bytes at a time with SSE2 when the compiler targets it,
+ * or 8 bytes at a time with 64-bit SWAR arithmetic otherwise.
+ *
+ * Only the ASCII letters `A`-`Z` and `a`-`z` are affected; bytes above
+ * 0x7F are left untouched, matching `ft_toupper` and `ft_tolower`.
+ *
+ * @note Block loads never cross a page boundary past the terminating
+ * `\0`: in-place conversion uses aligned blocks, and the comparisons only
+ * use unaligned blocks when both pointers are far enough from the end of
+ * their page. Reading a few bytes past the `\0` within the page is
+ * intentional and harmless, but AddressSanitizer reports it as an
+ * overflow, so the block helpers are built without its checks
+ * (`FT_NO_ASAN`), like the `strlen` and `memchr` kernels of C
+ * libraries.
+ *
+ * @ingroup string_utils
+ */
+
+#include "libft.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#define CASE_BLOCK 16
+#else
+#define CASE_BLOCK 8
+#endif
+
+#define CASE_PAGE_SIZE 4096
+#define SWAR_ONES 0x0101010101010101ULL
+#define SWAR_HIGHS 0x8080808080808080ULL
+#define SWAR_LOWS 0x7F7F7F7F7F7F7F7FULL
+
+/**
+ * @internal
+ * @brief Checks that a block load at @p p stays within its page.
+ */
+static int block_is_page_safe(const void* p)
+{
+	return (((uintptr_t) p & (CASE_PAGE_SIZE - 1)) <=
+	        CASE_PAGE_SIZE - CASE_BLOCK);
+}
+
+#ifdef __SSE2__
+
+/**
+ * @internal
+ * @brief Flips the case of every byte of @p v in [@p lo, @p hi].
+ *
+ * @details
+ * Uses signed comparisons, so bytes above 0x7F (negative) never match.
+ */
+static __m128i sse_flip_range(__m128i v, char lo, char hi)
+{
+	__m128i in_range;
+
+	in_range = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+	                         _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+	return (_mm_xor_si128(v, _mm_and_si128(in_range, _mm_set1_epi8(0x20))));
+}
+
+/**
+ * @internal
+ * @brief Converts aligned 16-byte blocks of @p s in place.
+ *
+ * @return Pointer to the first block containing the terminator.
+ *
+ * @note The last block may extend past the terminator, within its page.
+ */
+FT_NO_ASAN static char* convert_blocks(char* s, char lo, char hi)
+{
+	__m128i v;
+
+	while (1)
+	{
+		v = _mm_load_si128((const __m128i*) s);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())))
+			return (s);
+		_mm_store_si128((__m128i*) s, sse_flip_range(v, lo, hi));
+		s += 16;
+	}
+}
+
+/**
+ * @internal
+ * @brief Lowers a 16-byte block of each string and compares them.
+ *
+ * @return Bitmask of positions that differ or hold a `\0` in @p s1.
+ *
+ * @note Reads 16 bytes from each string whatever their length: the
+ *       caller checks the loads stay within their pages.
+ */
+FT_NO_ASAN static int casecmp_block(const char* s1, const char* s2)
+{
+	__m128i a;
+	__m128i b;
+	__m128i stop;
+
+	a    = _mm_loadu_si128((const __m128i*) s1);
+	b    = _mm_loadu_si128((const __m128i*) s2);
+	stop = _mm_cmpeq_epi8(a, _mm_setzero_si128());
+	a    = sse_flip_range(a, 'A', 'Z');
+	b    = sse_flip_range(b, 'A', 'Z');
+	stop = _mm_or_si128(stop, _mm_xor_si128(_mm_cmpeq_epi8(a, b),
+	                                        _mm_set1_epi8(-1)));
+	return (_mm_movemask_epi8(stop));
+}
+
+#else
+
+/**
+ * @internal
+ * @brief Flips the case bit of every byte of @p w in [@p lo, @p hi].
+ *
+ * @details
+ * Classic SWAR range test: each byte is reduced to its low 7 bits so the
+ * per-byte additions cannot carry into the neighbouring byte, and bytes
+ * with their high bit set (non-ASCII) are masked out at the end.
+ */
+static uint64_t swar_flip_range(uint64_t w, unsigned char lo,
+                                unsigned char hi)
+{
+	uint64_t low7;
+	uint64_t ge_lo;
+	uint64_t gt_hi;
+	uint64_t mask;
+
+	low7  = w & SWAR_LOWS;
+	ge_lo = low7 + SWAR_ONES * (0x80 - lo);
+	gt_hi = low7 + SWAR_ONES * (0x7F - hi);
+	mask  = ge_lo & ~gt_hi & ~w & SWAR_HIGHS;
+	return (w ^ (mask >> 2));
+}
+
+/**
+ * @internal
+ * @brief Returns non-zero if any byte of @p w is zero.
+ */
+static uint64_t swar_has_zero(uint64_t w)
+{
+	return ((w - SWAR_ONES) & ~w & SWAR_HIGHS);
+}
+
+/**
+ * @internal
+ * @brief Converts aligned 8-byte words of @p s in place.
+ *
+ * @return Pointer to the first word containing the terminator.
+ *
+ * @note The last word may extend past the terminator, within its page.
+ */
+FT_NO_ASAN static char* convert_blocks(char* s, char lo, char hi)
+{
+	uint64_t w;
+
+	while (1)
+	{
+		w = *(const uint64_t*) s;
+		if (swar_has_zero(w))
+			return (s);
+		*(uint64_t*) s = swar_flip_range(w, lo, hi);
+		s += 8;
+	}
+}
+
+/**
+ * @internal
+ * @brief Lowers an 8-byte word of each string and compares them.
+ *
+ * @return Non-zero if the words differ or @p s1 holds a `\0`.
+ *
+ * @note Reads 8 bytes from each string whatever their length: the
+ *       caller checks the loads stay within their pages.
+ */
+FT_NO_ASAN static int casecmp_block(const char* s1, const char* s2)
+{
+	uint64_t a;
+	uint64_t b;
+
+	__builtin_memcpy(&a, s1, 8);
+	__builtin_memcpy(&b, s2, 8);
+	if (swar_has_zero(a))
+		return (1);
+	return (swar_flip_range(a, 'A', 'Z') != swar_flip_range(b, 'A', 'Z'));
+}
+
+#endif
+
+/**
+ * @internal
+ * @brief Converts @p s in place, flipping letters in [@p lo, @p hi].
+ *
+ * @details
+ * Handles the unaligned head byte by byte, then runs the block loop on
+ * aligned memory, and finishes the block holding the terminator byte by
+ * byte.
+ */
+static char* convert_inplace(char* s, char lo, char hi)
+{
+	char* p;
+
+	if (!s)
+		return (NULL);
+	p = s;
+	while ((uintptr_t) p & (CASE_BLOCK - 1))
+	{
+		if (!*p)
+			return (s);
+		if (*p >= lo && *p <= hi)
+			*p ^= 0x20;
+		p++;
+	}
+	p = convert_blocks(p, lo, hi);
+	while (*p)
+	{
+		if (*p >= lo && *p <= hi)
+			*p ^= 0x20;
+		p++;
+	}
+	return (s);
+}
+
+/**
+ * @brief Converts every ASCII lowercase letter of a string to uppercase.
+ *
+ * @details
+ * Equivalent to applying `ft_toupper` to each byte of @p s, but works on
+ * whole blocks of the string at once without any per-character call.
+ *
+ * @param s The null-terminated string to convert in place.
+ * @return @p s, or NULL if @p s is NULL.
+ *
+ * @see ft_toupper
+ * @see ft_str_tolower_inplace
+ * @ingroup string_utils
+ */
+char* ft_str_toupper_inplace(char* s)
+{
+	return (convert_inplace(s, 'a', 'z'));
+}
+
+/**
+ * @brief Converts every ASCII uppercase letter of a string to lowercase.
+ *
+ * @details
+ * Equivalent to applying `ft_tolower` to each byte of @p s, but works on
+ * whole blocks of the string at once without any per-character call.
+ *
+ * @param s The null-terminated string to convert in place.
+ * @return @p s, or NULL if @p s is NULL.
+ *
+ * @see ft_tolower
+ * @see ft_str_toupper_inplace
+ * @ingroup string_utils
+ */
+char* ft_str_tolower_inplace(char* s)
+{
+	return (convert_inplace(s, 'A', 'Z'));
+}
+
+/**
+ * @brief Compares two strings up to `n` bytes, ignoring ASCII case.
+ *
+ * @details
+ * Whole blocks are compared while at least one block remains in the bound
+ * and neither pointer is near the end of its page. The first block that
+ * differs, or holds the terminator of @p s1, is resolved byte by byte.
+ *
+ * @param s1 First string to compare.
+ * @param s2 Second string to compare.
+ * @param n  Maximum number of bytes to compare.
+ *
+ * @return The difference between the first pair of lowercased bytes
+ *         that differ, or 0 if the strings match within `n` bytes.
+ *
+ * @see ft_strcasecmp
+ * @see ft_strncmp
+ * @ingroup string_utils
+ */
+int ft_strncasecmp(const char* s1, const char* s2, size_t n)
+{
+	unsigned char c1;
+	unsigned char c2;
+	size_t        step;
+
+	while (n > 0)
+	{
+		if (n >= CASE_BLOCK && block_is_page_safe(s1) &&
+		    block_is_page_safe(s2) && !casecmp_block(s1, s2))
+		{
+			s1 += CASE_BLOCK;
+			s2 += CASE_BLOCK;
+			n -= CASE_BLOCK;
+			continue;
+		}
+		step = (n < CASE_BLOCK) ? n : CASE_BLOCK;
+		while (step--)
+		{
+			c1 = ft_tolower((unsigned char) *s1++);
+			c2 = ft_tolower((unsigned char) *s2++);
+			if (c1 != c2 || c1 == '\0')
+				return (c1 - c2);
+			n--;
+		}
+	}
+	return (0);
+}
+
+/**
+ * @brief Compares two strings, ignoring ASCII case.
+ *
+ * @param s1 First null-terminated string.
+ * @param s2 Second null-terminated string.
+ *
+ * @return The difference between the first pair of lowercased bytes
+ *         that differ, or 0 if the strings are equal ignoring case.
+ *
+ * @see ft_strncasecmp
+ * @see ft_strcmp
+ * @ingroup string_utils
+ */
+int ft_strcasecmp(const char* s1, const char* s2)
+{
+	return (ft_strncasecmp(s1, s2, SIZE_MAX));
+}
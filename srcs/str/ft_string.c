@@ -24,6 +24,31 @@ size_t ft_strlen(const char* str)
 	return (len);
 }
 
+/**
+ * @brief Returns the length of a string, reading at most `maxlen` bytes.
+ *
+ * Stops at the first `\0` or after `maxlen` characters, whichever comes
+ * first, so only the part of the string that is actually needed is read.
+ * The string does not have to be null-terminated if it is at least
+ * `maxlen` bytes long.
+ *
+ * @param str    The string to measure.
+ * @param maxlen The maximum number of characters to examine.
+ * @return The length of `str`, or `maxlen` if it is longer.
+ *
+ * @see ft_strlen
+ * @ingroup string_utils
+ */
+size_t ft_strnlen(const char* str, size_t maxlen)
+{
+	size_t len;
+
+	len = 0;
+	while (len < maxlen && str[len] != '\0')
+		len++;
+	return (len);
+}
+
 /**
  * @brief Appends the `src` string to the end of the `dest` string.
  *
@@ -207,25 +232,47 @@ size_t ft_strlcpy(char* dest, const char* src, size_t size)
  *
  * Allocates memory for a copy of the string `src`, copies its contents
  * (including the null terminator), and returns a pointer to the new string.
+ * The string is scanned once to measure it and then copied in bulk.
  *
  * @param src The source string to duplicate.
  * @return A pointer to the newly allocated string, or NULL on allocation
  * failure.
  *
- * @see ft_strlcpy
+ * @see ft_strdup_len
  * @see ft_strlen
  * @ingroup string_utils
  */
 char* ft_strdup(const char* src)
 {
-	char*  copy;
-	size_t src_len;
+	return (ft_strdup_len(src, ft_strlen(src)));
+}
+
+/**
+ * @brief Allocates a null-terminated copy of `len` bytes of a string.
+ *
+ * For callers that already know the length of `src`: the bytes are
+ * copied with `ft_memcpy` without scanning for the terminator. `src` must
+ * hold at least `len` readable bytes; a `\0` among them is copied as is.
+ *
+ * @param src The source bytes.
+ * @param len The number of bytes to copy.
+ * @return A pointer to the newly allocated string, or NULL on allocation
+ * failure.
+ *
+ * @see ft_strdup
+ * @see ft_memdup
+ * @ingroup string_utils
+ */
+char* ft_strdup_len(const char* src, size_t len)
+{
+	char* copy;
 
-	src_len = ft_strlen(src);
-	copy    = (char*) malloc((src_len + 1) * sizeof(char));
+	copy = (char*) malloc((len + 1) * sizeof(char));
 	if (!copy)
 		return (NULL);
-	ft_strlcpy(copy, src, src_len + 1);
+	if (len > 0)
+		ft_memcpy(copy, src, len);
+	copy[len] = '\0';
 	return (copy);
 }
 
@@ -382,7 +429,8 @@ char* ft_strmapi(char const* s, char (*f)(unsigned int, char))
  *
  * This function allocates memory and copies at most `n` characters
  * from the string `src` to a new string. The new string is always
- * null-terminated.
+ * null-terminated. No more than `n` characters of `src` are read, so
+ * `src` does not need to be null-terminated if it is at least `n` long.
  *
  * @param src The source string to duplicate.
  * @param n   The maximum number of characters to copy.
@@ -390,23 +438,13 @@ char* ft_strmapi(char const* s, char (*f)(unsigned int, char))
  * @return A pointer to the newly allocated string, or NULL if memory
  *         allocation fails.
  *
- * @see ft_strlcpy
- * @see ft_strlen
+ * @see ft_strnlen
+ * @see ft_strdup_len
  * @ingroup string_utils
  */
 char* ft_strndup(const char* src, size_t n)
 {
-	char*  copy;
-	size_t src_len;
-
-	src_len = ft_strlen(src);
-	if (n < src_len)
-		src_len = n;
-	copy = (char*) malloc((src_len + 1) * sizeof(char));
-	if (!copy)
-		return (NULL);
-	ft_strlcpy(copy, src, src_len + 1);
-	return (copy);
+	return (ft_strdup_len(src, ft_strnlen(src, n)));
 }
 
 /**
@@ -498,35 +536,21 @@ char* ft_strrchr(const char* str, int c)
  * @return A newly allocated string containing the substring, or NULL if memory
  * allocation fails. If `start` is out of bounds, an empty string is returned.
  *
- * @see ft_strlen
- * @see ft_strlcpy
+ * @note Only the first `start + len` characters of `s` are read, so the
+ *       cost does not depend on the length of the rest of the string.
+ *
+ * @see ft_strnlen
+ * @see ft_strdup_len
  * @ingroup string_utils
  */
 char* ft_substr(const char* s, unsigned int start, size_t len)
 {
-	char*  substr;
-	size_t str_len;
-	size_t max_len;
-
 	if (s == NULL)
 		return (NULL);
-	str_len = ft_strlen(s);
-	if (start >= str_len)
-	{
-		substr = (char*) malloc(sizeof(char));
-		if (substr == NULL)
-			return (NULL);
-		substr[0] = '\0';
-		return (substr);
-	}
-	max_len = str_len - start;
-	if (max_len > len)
-		max_len = len;
-	substr = (char*) malloc((max_len + 1) * sizeof(char));
-	if (substr == NULL)
-		return (NULL);
-	ft_strlcpy(substr, s + start, max_len + 1);
-	return (substr);
+	if (ft_strnlen(s, start) < start)
+		return (ft_strdup_len("", 0));
+	s += start;
+	return (ft_strdup_len(s, ft_strnlen(s, len)));
 }
 
 /**
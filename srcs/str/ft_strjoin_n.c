@@ -0,0 +1,222 @@
+/**
+ * @file ft_strjoin_n.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief Joins many strings with a single allocation.
+ *
+ * @details
+ * Building a string from k pieces with nested `ft_strjoin` calls copies
+ * the growing prefix k - 1 times and allocates k - 1 intermediate
+ * strings. The functions in this file measure every piece once, allocate
+ * the result once, and copy every piece exactly once:
+ * - `ft_strjoin_n` joins a variadic list of strings.
+ * - `ft_strarr_join` joins a NULL-terminated array with a separator, and
+ *   is the inverse of `ft_split`.
+ *
+ * The lengths measured in the first pass are kept, in a small stack
+ * array or, for more pieces, a heap array, so the copy pass moves every
+ * piece with `ft_memcpy` without scanning it again. A total length that
+ * would overflow `size_t` fails the call instead of wrapping around.
+ *
+ * @ingroup string_utils
+ */
+
+#include "libft.h"
+
+/**
+ * @brief Number of piece lengths kept on the stack between the two
+ *        passes.
+ *
+ * Joins of more pieces keep their lengths in a heap array instead.
+ */
+#define JOIN_LEN_CACHE 32
+
+/**
+ * @internal
+ * @brief Returns room for @p count piece lengths.
+ *
+ * @param stack A `JOIN_LEN_CACHE`-entry stack array.
+ * @param count Number of pieces.
+ * @return @p stack if it is large enough, a heap array otherwise, or
+ *         NULL if allocation fails.
+ */
+static size_t* get_lens(size_t* stack, size_t count)
+{
+	if (count <= JOIN_LEN_CACHE)
+		return (stack);
+	if (count > SIZE_MAX / sizeof(size_t))
+		return (NULL);
+	return (malloc(count * sizeof(size_t)));
+}
+
+/**
+ * @internal
+ * @brief Adds @p len to @p total unless the result plus a terminator
+ *        would not fit in a `size_t`.
+ *
+ * @return 0 on success, -1 on overflow.
+ */
+static int add_len(size_t* total, size_t len)
+{
+	if (len >= SIZE_MAX - *total)
+		return (-1);
+	*total += len;
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Allocates the result and frees @p lens if it is on the heap.
+ *
+ * @return The result buffer, or NULL on overflow or allocation failure.
+ */
+static char* alloc_result(size_t total, int overflow, size_t* lens,
+                          const size_t* stack)
+{
+	char* result;
+
+	result = NULL;
+	if (!overflow)
+		result = (char*) malloc((total + 1) * sizeof(char));
+	if (!result && lens != stack)
+		free(lens);
+	return (result);
+}
+
+/**
+ * @brief Concatenates `count` strings into a newly allocated string.
+ *
+ * @details
+ * Equivalent to chaining `ft_strjoin` over all the arguments, but with
+ * one allocation and one copy per piece. NULL arguments are treated as
+ * empty strings, as in `ft_strjoin`.
+ *
+ * @param count Number of string arguments that follow.
+ * @param ...   The `const char*` pieces to join, in order.
+ *
+ * @return The joined string, or NULL if memory allocation fails or the
+ *         total length overflows.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ *
+ * @see ft_strjoin
+ * @see ft_strarr_join
+ * @ingroup string_utils
+ */
+char* ft_strjoin_n(size_t count, ...)
+{
+	va_list     args;
+	size_t      stack[JOIN_LEN_CACHE];
+	size_t*     lens;
+	size_t      total;
+	size_t      i;
+	int         overflow;
+	const char* piece;
+	char*       result;
+	char*       cursor;
+
+	lens = get_lens(stack, count);
+	if (!lens)
+		return (NULL);
+	va_start(args, count);
+	total    = 0;
+	overflow = 0;
+	i        = 0;
+	while (i < count)
+	{
+		piece   = va_arg(args, const char*);
+		lens[i] = (piece) ? ft_strlen(piece) : 0;
+		overflow |= add_len(&total, lens[i++]);
+	}
+	va_end(args);
+	result = alloc_result(total, overflow, lens, stack);
+	if (!result)
+		return (NULL);
+	cursor = result;
+	va_start(args, count);
+	i = 0;
+	while (i < count)
+	{
+		piece = va_arg(args, const char*);
+		if (piece)
+			ft_memcpy(cursor, piece, lens[i]);
+		cursor += lens[i++];
+	}
+	va_end(args);
+	*cursor = '\0';
+	if (lens != stack)
+		free(lens);
+	return (result);
+}
+
+/**
+ * @brief Joins a NULL-terminated string array, inserting a separator.
+ *
+ * @details
+ * The inverse of `ft_split`: `ft_strarr_join(ft_split(s, c), "c")`
+ * rebuilds @p s minus any repeated, leading or trailing delimiters. The
+ * result is allocated once and each element is copied exactly once.
+ *
+ * @param arr The NULL-terminated array of strings to join.
+ * @param sep The separator placed between elements (NULL means none).
+ *
+ * @return The joined string (empty if @p arr has no element), or NULL if
+ *         @p arr is NULL, memory allocation fails or the total length
+ *         overflows.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ *
+ * @see ft_split
+ * @see ft_strjoin_n
+ * @ingroup string_utils
+ */
+char* ft_strarr_join(char** arr, const char* sep)
+{
+	size_t  stack[JOIN_LEN_CACHE];
+	size_t* lens;
+	size_t  sep_len;
+	size_t  total;
+	size_t  i;
+	int     overflow;
+	char*   result;
+	char*   cursor;
+
+	if (!arr)
+		return (NULL);
+	i = 0;
+	while (arr[i])
+		i++;
+	lens = get_lens(stack, i);
+	if (!lens)
+		return (NULL);
+	sep_len  = (sep) ? ft_strlen(sep) : 0;
+	total    = 0;
+	overflow = 0;
+	i        = 0;
+	while (arr[i])
+	{
+		lens[i] = ft_strlen(arr[i]);
+		if (i > 0)
+			overflow |= add_len(&total, sep_len);
+		overflow |= add_len(&total, lens[i++]);
+	}
+	result = alloc_result(total, overflow, lens, stack);
+	if (!result)
+		return (NULL);
+	cursor = result;
+	i      = 0;
+	while (arr[i])
+	{
+		if (i > 0 && sep_len > 0)
+		{
+			ft_memcpy(cursor, sep, sep_len);
+			cursor += sep_len;
+		}
+		ft_memcpy(cursor, arr[i], lens[i]);
+		cursor += lens[i++];
+	}
+	*cursor = '\0';
+	if (lens != stack)
+		free(lens);
+	return (result);
+}
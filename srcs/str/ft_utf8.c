@@ -0,0 +1,479 @@
+/**
+ * @file ft_utf8.c
+ * @author Toonsa
+ * @date 2026/10/19
+ * @brief UTF-8 validation, codepoint counting and codepoint substrings.
+ *
+ * @details
+ * The rest of the string module works on bytes. This file adds the few
+ * UTF-8 aware helpers needed to accept untrusted text safely:
+ * - `ft_utf8_validate` checks a buffer against the Unicode well-formed
+ *   byte sequence table (no overlongs, surrogates or values > U+10FFFF).
+ * - `ft_utf8_strlen` counts codepoints instead of bytes.
+ * - `ft_utf8_substr` extracts a substring by codepoint index and length.
+ *
+ * On x86-64, validation uses the vectorized range-table algorithm of
+ * Keiser and Lemire: three 16-entry nibble lookups (`pshufb`) classify
+ * every pair of adjacent bytes, so a 16-byte block is checked with a
+ * handful of instructions and no branches. The SSSE3 kernel is selected
+ * at run time, so the library still works on CPUs without it. Other
+ * targets use a scalar range-table walk with an 8-byte ASCII fast path.
+ *
+ * @ingroup string_utils
+ */
+
+#include "libft.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define UTF8_SSSE3_KERNEL
+#include <tmmintrin.h>
+#define UTF8_TARGET __attribute__((target("ssse3")))
+#endif
+
+#define UTF8_ASCII_MASK 0x8080808080808080ULL
+
+/**
+ * @internal
+ * @brief Returns the length of the sequence led by @p c and the valid
+ * range of its second byte, or 0 if @p c cannot start a sequence.
+ *
+ * @details
+ * Encodes Table 3-7 of the Unicode standard: the lead byte alone fixes
+ * the sequence length, and only the second byte has a narrower range
+ * than `80..BF` (to reject overlongs, surrogates and values above
+ * U+10FFFF).
+ */
+static size_t utf8_lead(unsigned char c, unsigned char* lo, unsigned char* hi)
+{
+	*lo = 0x80;
+	*hi = 0xBF;
+	if (c < 0x80)
+		return (1);
+	if (c >= 0xC2 && c <= 0xDF)
+		return (2);
+	if (c >= 0xE0 && c <= 0xEF)
+	{
+		if (c == 0xE0)
+			*lo = 0xA0;
+		else if (c == 0xED)
+			*hi = 0x9F;
+		return (3);
+	}
+	if (c >= 0xF0 && c <= 0xF4)
+	{
+		if (c == 0xF0)
+			*lo = 0x90;
+		else if (c == 0xF4)
+			*hi = 0x8F;
+		return (4);
+	}
+	return (0);
+}
+
+/**
+ * @internal
+ * @brief Portable validator: 8-byte ASCII skip, then table-driven walk.
+ */
+static bool utf8_validate_scalar(const unsigned char* s, size_t len)
+{
+	uint64_t      word;
+	size_t        seq;
+	size_t        i;
+	unsigned char lo;
+	unsigned char hi;
+
+	while (len > 0)
+	{
+		if (len >= 8)
+		{
+			ft_memcpy(&word, s, 8);
+			if (!(word & UTF8_ASCII_MASK))
+			{
+				s += 8;
+				len -= 8;
+				continue;
+			}
+		}
+		seq = utf8_lead(*s, &lo, &hi);
+		if (seq == 0 || seq > len)
+			return (false);
+		if (seq > 1 && (s[1] < lo || s[1] > hi))
+			return (false);
+		i = 2;
+		while (i < seq)
+		{
+			if ((s[i] & 0xC0) != 0x80)
+				return (false);
+			i++;
+		}
+		s += seq;
+		len -= seq;
+	}
+	return (true);
+}
+
+#ifdef UTF8_SSSE3_KERNEL
+
+#define TOO_SHORT (1 << 0)
+#define TOO_LONG (1 << 1)
+#define OVERLONG_3 (1 << 2)
+#define TOO_LARGE (1 << 3)
+#define SURROGATE (1 << 4)
+#define OVERLONG_2 (1 << 5)
+#define TOO_LARGE_1000 (1 << 6)
+#define OVERLONG_4 (1 << 6)
+#define TWO_CONTS (1 << 7)
+#define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)
+#define HI_BITS (TOO_LARGE | TOO_LARGE_1000)
+
+/**
+ * @internal
+ * @brief Running state of the vectorized validator.
+ */
+typedef struct s_utf8_simd
+{
+	__m128i prev_input;      ///< Previous 16-byte block.
+	__m128i prev_incomplete; ///< Lead bytes still waiting for continuations.
+	__m128i error;           ///< Accumulated error bits.
+} t_utf8_simd;
+
+/**
+ * @internal
+ * @brief Classifies each (previous byte, current byte) pair.
+ *
+ * @details
+ * Each lookup maps a nibble to the set of errors that nibble allows; a
+ * bit survives the AND only if all three nibbles agree on the error.
+ */
+UTF8_TARGET static __m128i utf8_special_cases(__m128i input, __m128i prev1)
+{
+	const __m128i nib     = _mm_set1_epi8(0x0F);
+	const __m128i b1h_tab = _mm_setr_epi8(
+	    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+	    TOO_LONG, (char) TWO_CONTS, (char) TWO_CONTS, (char) TWO_CONTS,
+	    (char) TWO_CONTS, TOO_SHORT | OVERLONG_2, TOO_SHORT,
+	    TOO_SHORT | OVERLONG_3 | SURROGATE,
+	    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+	const __m128i b1l_tab = _mm_setr_epi8(
+	    (char) (CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4),
+	    (char) (CARRY | OVERLONG_2), (char) CARRY, (char) CARRY,
+	    (char) (CARRY | TOO_LARGE), (char) (CARRY | HI_BITS),
+	    (char) (CARRY | HI_BITS), (char) (CARRY | HI_BITS),
+	    (char) (CARRY | HI_BITS), (char) (CARRY | HI_BITS),
+	    (char) (CARRY | HI_BITS), (char) (CARRY | HI_BITS),
+	    (char) (CARRY | HI_BITS), (char) (CARRY | HI_BITS | SURROGATE),
+	    (char) (CARRY | HI_BITS), (char) (CARRY | HI_BITS));
+	const __m128i b2h_tab = _mm_setr_epi8(
+	    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+	    TOO_SHORT, TOO_SHORT,
+	    (char) (TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 |
+	            TOO_LARGE_1000 | OVERLONG_4),
+	    (char) (TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+	    (char) (TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+	    (char) (TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+	    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+	__m128i b1h;
+	__m128i b1l;
+	__m128i b2h;
+
+	b1h = _mm_shuffle_epi8(b1h_tab,
+	                       _mm_and_si128(_mm_srli_epi16(prev1, 4), nib));
+	b1l = _mm_shuffle_epi8(b1l_tab, _mm_and_si128(prev1, nib));
+	b2h = _mm_shuffle_epi8(b2h_tab,
+	                       _mm_and_si128(_mm_srli_epi16(input, 4), nib));
+	return (_mm_and_si128(_mm_and_si128(b1h, b1l), b2h));
+}
+
+/**
+ * @internal
+ * @brief Feeds one 16-byte block into the validator state.
+ *
+ * @details
+ * Besides the pairwise classification, the third and fourth bytes of
+ * 3- and 4-byte sequences must be continuations exactly when a lead two
+ * or three bytes back asks for them. The last bytes of the block are
+ * remembered in case a sequence continues into the next block.
+ */
+UTF8_TARGET static void utf8_check_block(t_utf8_simd* st, __m128i input)
+{
+	const __m128i max_tail = _mm_setr_epi8(
+	    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char) 0xEF,
+	    (char) 0xDF, (char) 0xBF);
+	__m128i prev1;
+	__m128i must23;
+	__m128i sc;
+
+	if (_mm_movemask_epi8(input) == 0)
+	{
+		st->error = _mm_or_si128(st->error, st->prev_incomplete);
+		st->prev_input = input;
+		return;
+	}
+	prev1  = _mm_alignr_epi8(input, st->prev_input, 15);
+	sc     = utf8_special_cases(input, prev1);
+	must23 = _mm_or_si128(
+	    _mm_subs_epu8(_mm_alignr_epi8(input, st->prev_input, 14),
+	                  _mm_set1_epi8((char) (0xE0 - 0x80))),
+	    _mm_subs_epu8(_mm_alignr_epi8(input, st->prev_input, 13),
+	                  _mm_set1_epi8((char) (0xF0 - 0x80))));
+	must23    = _mm_and_si128(must23, _mm_set1_epi8((char) 0x80));
+	st->error = _mm_or_si128(st->error, _mm_xor_si128(must23, sc));
+	st->prev_incomplete = _mm_subs_epu8(input, max_tail);
+	st->prev_input      = input;
+}
+
+/**
+ * @internal
+ * @brief SSSE3 validator; the tail is zero-padded into one last block.
+ */
+UTF8_TARGET static bool utf8_validate_ssse3(const unsigned char* s,
+                                            size_t               len)
+{
+	t_utf8_simd   st;
+	unsigned char tail[16];
+
+	st.prev_input      = _mm_setzero_si128();
+	st.prev_incomplete = _mm_setzero_si128();
+	st.error           = _mm_setzero_si128();
+	while (len >= 16)
+	{
+		utf8_check_block(&st, _mm_loadu_si128((const __m128i*) s));
+		s += 16;
+		len -= 16;
+	}
+	if (len > 0)
+	{
+		ft_bzero(tail, sizeof(tail));
+		ft_memcpy(tail, s, len);
+		utf8_check_block(&st, _mm_loadu_si128((const __m128i*) tail));
+	}
+	st.error = _mm_or_si128(st.error, st.prev_incomplete);
+	return (_mm_movemask_epi8(_mm_cmpeq_epi8(st.error, _mm_setzero_si128())) ==
+	        0xFFFF);
+}
+
+/**
+ * @internal
+ * @brief Returns 1 if the running CPU supports SSSE3 (cached).
+ *
+ * @details
+ * The cache is atomic: threads racing on the first call each compute
+ * the same answer and store it.
+ */
+static int utf8_cpu_has_ssse3(void)
+{
+	static atomic_int supported = -1;
+	int               result;
+
+	result = atomic_load_explicit(&supported, memory_order_relaxed);
+	if (result < 0)
+	{
+		__builtin_cpu_init();
+		result = __builtin_cpu_supports("ssse3") ? 1 : 0;
+		atomic_store_explicit(&supported, result, memory_order_relaxed);
+	}
+	return (result);
+}
+
+#endif
+
+/**
+ * @brief Checks whether a buffer holds well-formed UTF-8.
+ *
+ * @details
+ * Rejects truncated sequences, stray continuation bytes, overlong
+ * encodings, UTF-16 surrogates (U+D800-U+DFFF) and codepoints above
+ * U+10FFFF. Embedded `\0` bytes are valid UTF-8 and are accepted.
+ *
+ * @param s   Pointer to the bytes to validate.
+ * @param len Number of bytes to validate.
+ * @return true if the `len` bytes are valid UTF-8, false otherwise.
+ *
+ * @note An empty buffer is valid. Returns false if @p s is NULL and
+ *       @p len is not zero.
+ *
+ * @see ft_utf8_strlen
+ * @ingroup string_utils
+ */
+bool ft_utf8_validate(const char* s, size_t len)
+{
+	if (len == 0)
+		return (true);
+	if (!s)
+		return (false);
+#ifdef UTF8_SSSE3_KERNEL
+	if (utf8_cpu_has_ssse3())
+		return (utf8_validate_ssse3((const unsigned char*) s, len));
+#endif
+	return (utf8_validate_scalar((const unsigned char*) s, len));
+}
+
+#ifdef __SSE2__
+
+/**
+ * @internal
+ * @brief Counts non-continuation bytes in aligned 16-byte blocks.
+ *
+ * @details
+ * A byte starts a codepoint unless it is `10xxxxxx`; as a signed char
+ * that is exactly the bytes greater than -65 (0xBF).
+ *
+ * @param p Aligned pointer, updated to the block holding the `\0`.
+ * @return Number of codepoints started before that block.
+ *
+ * @note The block holding the `\0` is read whole, past the string's end
+ *       but within its page; hence `FT_NO_ASAN`.
+ */
+FT_NO_ASAN static size_t count_blocks(const char** p)
+{
+	const __m128i lead_min = _mm_set1_epi8(-65);
+	__m128i       v;
+	size_t        count;
+
+	count = 0;
+	while (1)
+	{
+		v = _mm_load_si128((const __m128i*) *p);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())))
+			return (count);
+		count += __builtin_popcount(
+		    _mm_movemask_epi8(_mm_cmpgt_epi8(v, lead_min)));
+		*p += 16;
+	}
+}
+
+#define UTF8_BLOCK 16
+
+#else
+
+/**
+ * @internal
+ * @brief Counts non-continuation bytes in aligned 8-byte words.
+ *
+ * @details
+ * For each byte, bit 7 set and bit 6 clear marks a continuation; the
+ * remaining bytes start a codepoint.
+ *
+ * @note The word holding the `\0` is read whole, past the string's end
+ *       but within its page; hence `FT_NO_ASAN`.
+ */
+FT_NO_ASAN static size_t count_blocks(const char** p)
+{
+	uint64_t w;
+	uint64_t cont;
+	size_t   count;
+
+	count = 0;
+	while (1)
+	{
+		w = *(const uint64_t*) *p;
+		if ((w - 0x0101010101010101ULL) & ~w & UTF8_ASCII_MASK)
+			return (count);
+		cont = w & ~(w << 1) & UTF8_ASCII_MASK;
+		count += 8 - __builtin_popcountll(cont);
+		*p += 8;
+	}
+}
+
+#define UTF8_BLOCK 8
+
+#endif
+
+/**
+ * @brief Counts the codepoints of a UTF-8 string.
+ *
+ * @details
+ * Counts every byte that is not a continuation byte (`10xxxxxx`). The
+ * string is scanned in aligned blocks, so the count runs at memory speed.
+ *
+ * @param s The null-terminated UTF-8 string.
+ * @return The number of codepoints in @p s, or 0 if @p s is NULL.
+ *
+ * @note The result is only meaningful for valid UTF-8; validate untrusted
+ *       input with `ft_utf8_validate` first.
+ *
+ * @see ft_utf8_validate
+ * @see ft_strlen
+ * @ingroup string_utils
+ */
+size_t ft_utf8_strlen(const char* s)
+{
+	size_t count;
+
+	if (!s)
+		return (0);
+	count = 0;
+	while ((uintptr_t) s & (UTF8_BLOCK - 1))
+	{
+		if (!*s)
+			return (count);
+		count += ((*s & 0xC0) != 0x80);
+		s++;
+	}
+	count += count_blocks(&s);
+	while (*s)
+	{
+		count += ((*s & 0xC0) != 0x80);
+		s++;
+	}
+	return (count);
+}
+
+/**
+ * @internal
+ * @brief Advances @p s by up to @p n codepoints, stopping at `\0`.
+ */
+static const char* utf8_skip(const char* s, size_t n)
+{
+	while (*s && n > 0)
+	{
+		s++;
+		while ((*s & 0xC0) == 0x80)
+			s++;
+		n--;
+	}
+	return (s);
+}
+
+/**
+ * @brief Extracts a substring by codepoint position and length.
+ *
+ * @details
+ * UTF-8 aware counterpart of `ft_substr`: @p start and @p len count
+ * codepoints, not bytes, so the result never splits a multi-byte
+ * sequence. If @p start is past the end, an empty string is returned.
+ *
+ * @param s     The source UTF-8 string.
+ * @param start Index of the first codepoint to copy.
+ * @param len   Maximum number of codepoints to copy.
+ *
+ * @return A newly allocated string, or NULL if @p s is NULL or memory
+ *         allocation fails.
+ *
+ * @note The caller is responsible for freeing the returned string.
+ *
+ * @see ft_substr
+ * @see ft_utf8_strlen
+ * @ingroup string_utils
+ */
+char* ft_utf8_substr(const char* s, size_t start, size_t len)
+{
+	const char* begin;
+	const char* end;
+	char*       substr;
+
+	if (!s)
+		return (NULL);
+	begin  = utf8_skip(s, start);
+	end    = utf8_skip(begin, len);
+	substr = (char*) malloc((end - begin + 1) * sizeof(char));
+	if (!substr)
+		return (NULL);
+	ft_memcpy(substr, begin, end - begin);
+	substr[end - begin] = '\0';
+	return (substr);
+}